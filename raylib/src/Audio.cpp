@@ -0,0 +1,299 @@
+#include "Audio.h"
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+static const int   SAMPLE_RATE = 22050;
+static const float PAN_WIDTH   = 0.8f;  // keep far-side sounds audible
+
+static const char* MUSIC_FILES[2] = {
+    "assests/audio/desert_theme.ogg",
+    "assests/audio/moon_theme.ogg"
+};
+
+// ---------------- SYNTHESIS --------------------
+// Built-in effects so the game has sound without shipping any files. A wav
+// with the same name under assests/audio/ replaces the generated one.
+
+static float Noise(unsigned& state) {
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / 8388608.0f - 1.0f;
+}
+
+static vector<short> Synth(SoundId id) {
+    float len = 0.0f;
+    switch (id) {
+        case SoundId::Fire:      len = 0.30f; break;
+        case SoundId::Impact:    len = 0.25f; break;
+        case SoundId::Explosion: len = 1.20f; break;
+        case SoundId::Click:     len = 0.04f; break;
+        default: break;
+    }
+
+    int n = (int)(len * SAMPLE_RATE);
+    vector<short> out(n);
+    unsigned rng = 12345u + (unsigned)id;
+    float lp = 0.0f, phase = 0.0f;
+
+    for (int i = 0; i < n; ++i) {
+        float t = (float)i / SAMPLE_RATE;
+        float s = 0.0f;
+        switch (id) {
+            case SoundId::Fire: {
+                // Falling thump plus a burst of hiss
+                phase += 2.0f * PI * (220.0f - 160.0f * t / len) / SAMPLE_RATE;
+                s = 0.6f * sinf(phase) * expf(-t * 12.0f) + 0.4f * Noise(rng) * expf(-t * 25.0f);
+            } break;
+            case SoundId::Impact: {
+                phase += 2.0f * PI * 90.0f / SAMPLE_RATE;
+                lp += (Noise(rng) - lp) * 0.3f;
+                s = (0.7f * sinf(phase) + 0.5f * lp) * expf(-t * 18.0f);
+            } break;
+            case SoundId::Explosion: {
+                // Low-passed noise rumble with a slow tail
+                lp += (Noise(rng) - lp) * 0.08f;
+                s = 2.5f * lp * expf(-t * 3.5f);
+            } break;
+            case SoundId::Click: {
+                phase += 2.0f * PI * 1800.0f / SAMPLE_RATE;
+                s = 0.5f * sinf(phase) * (1.0f - t / len);
+            } break;
+            default: break;
+        }
+        if (s > 1.0f) s = 1.0f;
+        if (s < -1.0f) s = -1.0f;
+        out[i] = (short)(s * 32000.0f);
+    }
+    return out;
+}
+
+// ---------------- ENGINE --------------------
+AudioEngine::AudioEngine()
+    : device(false), clock(0.0), serial(0),
+      loaded(false),
+      played(0), stolen(0), dropped(0),
+      hasMusic{ false, false },
+      playingMusic(-1)
+{
+    for (int s = 0; s < AUDIO_SOUNDS; ++s) {
+        copies[s] = 0; duration[s] = 0.0f; priority[s] = 0;
+        for (int c = 0; c < AUDIO_COPIES; ++c) sounds[s][c] = {};
+    }
+    for (Voice& v : voices) v = { -1, 0, 0, 0.0, 0 };
+    music[0] = {}; music[1] = {};
+}
+
+void AudioEngine::LoadEffect(SoundId id, const char* file, int nCopies, int prio) {
+    int s = (int)id;
+    copies[s]   = nCopies;
+    priority[s] = prio;
+
+    Wave wave = {};
+    bool fromFile = device && FileExists(file);
+    if (fromFile) {
+        wave = LoadWave(file);
+    } else {
+        pcm[s] = Synth(id);
+        wave.frameCount = (unsigned)pcm[s].size();
+        wave.sampleRate = SAMPLE_RATE;
+        wave.sampleSize = 16;
+        wave.channels   = 1;
+        wave.data       = pcm[s].data();
+    }
+    duration[s] = (wave.sampleRate > 0) ? (float)wave.frameCount / wave.sampleRate : 0.0f;
+
+    if (device)
+        for (int c = 0; c < nCopies; ++c) sounds[s][c] = LoadSoundFromWave(wave);
+
+    if (fromFile) UnloadWave(wave);
+}
+
+void AudioEngine::Init(bool useDevice) {
+    device = useDevice;
+
+    LoadEffect(SoundId::Fire,      "assests/audio/fire.wav",      2, 2);
+    LoadEffect(SoundId::Impact,    "assests/audio/impact.wav",    6, 2);
+    LoadEffect(SoundId::Explosion, "assests/audio/explosion.wav", 3, 3);
+    LoadEffect(SoundId::Click,     "assests/audio/click.wav",     2, 1);
+    loaded = true;
+
+    for (int b = 0; b < 2; ++b) {
+        hasMusic[b] = device && FileExists(MUSIC_FILES[b]);
+        if (!hasMusic[b]) continue;
+        music[b] = LoadMusicStream(MUSIC_FILES[b]);
+        music[b].looping = true;
+        SetMusicVolume(music[b], 0.5f);
+    }
+
+    if (!device) TraceLog(LOG_INFO, "AUDIO: no audio device, sounds are tracked but silent");
+}
+
+void AudioEngine::Unload() {
+    if (!loaded) return;
+    LogStats();
+    StopMusic();
+    if (device) {
+        for (int s = 0; s < AUDIO_SOUNDS; ++s)
+            for (int c = 0; c < copies[s]; ++c) UnloadSound(sounds[s][c]);
+        for (int b = 0; b < 2; ++b)
+            if (hasMusic[b]) UnloadMusicStream(music[b]);
+    }
+    for (int b = 0; b < 2; ++b) hasMusic[b] = false;
+    for (Voice& v : voices) v.sound = -1;
+    loaded = false;
+}
+
+void AudioEngine::Update(double now) {
+    clock = now;
+    Retire();
+    if (device && playingMusic >= 0) UpdateMusicStream(music[playingMusic]);
+}
+
+// Voices end by the clock rather than by asking the device, so the pool
+// behaves the same with or without real audio output
+void AudioEngine::Retire() {
+    for (Voice& v : voices)
+        if (v.sound >= 0 && v.endTime <= clock) v.sound = -1;
+}
+
+bool AudioEngine::CopyInUse(int sound, int copy) const {
+    for (const Voice& v : voices)
+        if (v.sound == sound && v.copy == copy) return true;
+    return false;
+}
+
+bool AudioEngine::Play(SoundId id, float pan) {
+    if (!loaded) return false;
+    Retire();
+
+    int s    = (int)id;
+    int prio = priority[s];
+
+    int copy = -1;
+    for (int c = 0; c < copies[s] && copy < 0; ++c)
+        if (!CopyInUse(s, c)) copy = c;
+
+    int slot = -1;
+    if (copy >= 0)
+        for (int i = 0; i < AUDIO_VOICES && slot < 0; ++i)
+            if (voices[i].sound < 0) slot = i;
+
+    if (slot < 0) {
+        // Steal the weakest voice we may replace: lowest priority, then
+        // oldest. Without a free buffer it has to be one of our own.
+        for (int i = 0; i < AUDIO_VOICES; ++i) {
+            const Voice& v = voices[i];
+            if (v.priority > prio) continue;
+            if (copy < 0 && v.sound != s) continue;
+            if (slot < 0 || v.priority < voices[slot].priority ||
+                (v.priority == voices[slot].priority && v.serial < voices[slot].serial))
+                slot = i;
+        }
+        if (slot < 0) { dropped++; return false; }
+
+        Voice& victim = voices[slot];
+        if (device) StopSound(sounds[victim.sound][victim.copy]);
+        if (copy < 0) copy = victim.copy;
+        stolen++;
+    }
+
+    voices[slot] = { s, copy, prio, clock + duration[s], serial++ };
+    played++;
+
+    if (device) {
+        if (pan < 0.0f) pan = 0.0f;
+        if (pan > 1.0f) pan = 1.0f;
+        // raylib 4.5 pans with 0.5 as center and 1.0 as full left
+        Sound& snd = sounds[s][copy];
+        SetSoundPan(snd, 0.5f - (pan - 0.5f) * PAN_WIDTH);
+        PlaySound(snd);
+    }
+    return true;
+}
+
+void AudioEngine::PlayMusic(BackgroundType bg) {
+    int b = (int)bg;
+    if (b == playingMusic) return;
+    StopMusic();
+    if (!hasMusic[b]) return;
+    PlayMusicStream(music[b]);
+    playingMusic = b;
+}
+
+void AudioEngine::StopMusic() {
+    if (playingMusic < 0) return;
+    if (device) StopMusicStream(music[playingMusic]);
+    playingMusic = -1;
+}
+
+int AudioEngine::ActiveVoices() const {
+    int n = 0;
+    for (const Voice& v : voices)
+        if (v.sound >= 0 && v.endTime > clock) n++;
+    return n;
+}
+
+int AudioEngine::ActiveVoices(SoundId id) const {
+    int n = 0;
+    for (const Voice& v : voices)
+        if (v.sound == (int)id && v.endTime > clock) n++;
+    return n;
+}
+
+void AudioEngine::LogStats() const {
+    if (played == 0 && dropped == 0) return;
+    TraceLog(LOG_INFO, "AUDIO: %d sounds played, %d voices stolen, %d sounds dropped (pool of %d voices)",
+             played, stolen, dropped, AUDIO_VOICES);
+}
+
+// ---------------- CHECK --------------------
+static void Expect(bool ok, const char* what, int& failures) {
+    printf("  [%s] %s\n", ok ? " OK " : "FAIL", what);
+    if (!ok) failures++;
+}
+
+int RunAudioCheck() {
+    int failures = 0;
+    AudioEngine audio;
+    audio.Init(false);
+    audio.Update(0.0);
+
+    printf("Audio voice pool check (%d voices, no device)\n", AUDIO_VOICES);
+
+    // A cluster salvo: far more impacts than buffers or voices
+    audio.Play(SoundId::Explosion, 0.2f);
+    for (int i = 0; i < 40; ++i) audio.Play(SoundId::Impact, i / 40.0f);
+    Expect(audio.ActiveVoices() <= AUDIO_VOICES, "burst stays inside the voice pool", failures);
+    Expect(audio.ActiveVoices(SoundId::Impact) == 6, "impacts recycle their own buffers", failures);
+    Expect(audio.ActiveVoices(SoundId::Explosion) == 1, "impacts never steal the louder explosion", failures);
+    Expect(audio.StolenVoices() > 0 && audio.DroppedSounds() == 0, "new impacts replace the oldest ones", failures);
+
+    // Fill the pool: 1 explosion + 6 impacts + 2 fire + 2 clicks + 1 explosion
+    audio.Play(SoundId::Fire);
+    audio.Play(SoundId::Fire);
+    audio.Play(SoundId::Click);
+    audio.Play(SoundId::Click);
+    audio.Play(SoundId::Explosion);
+    Expect(audio.ActiveVoices() == AUDIO_VOICES, "pool is full", failures);
+
+    // With no voice free, an explosion takes the lowest priority one (a click)
+    int stolenBefore = audio.StolenVoices();
+    audio.Play(SoundId::Explosion);
+    Expect(audio.StolenVoices() == stolenBefore + 1, "full pool steals a voice", failures);
+    Expect(audio.ActiveVoices(SoundId::Click) == 1, "the stolen voice was a click", failures);
+    Expect(audio.ActiveVoices(SoundId::Explosion) == 3, "explosion is playing", failures);
+    Expect(audio.ActiveVoices() == AUDIO_VOICES, "still inside the voice pool", failures);
+
+    // A click has nothing of equal or lower priority left but the other click
+    audio.Play(SoundId::Click);
+    Expect(audio.ActiveVoices(SoundId::Impact) == 6 && audio.ActiveVoices(SoundId::Fire) == 2,
+           "a click never steals higher priority voices", failures);
+
+    audio.Update(5.0);
+    Expect(audio.ActiveVoices() == 0, "voices retire once their sound has finished", failures);
+
+    audio.Unload();
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
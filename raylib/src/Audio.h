@@ -0,0 +1,71 @@
+#pragma once
+#include "raylib.h"
+#include "Types.h"
+#include <vector>
+
+static const int AUDIO_SOUNDS = (int)SoundId::Count;
+static const int AUDIO_VOICES = 12;
+static const int AUDIO_COPIES = 6;  // most buffers any one sound gets
+
+// Sound effects and background music. Every effect is decoded up front into
+// a few identical buffers, and at most AUDIO_VOICES of them play at once:
+// when the pool is full a new sound takes over the lowest priority, oldest
+// voice. Play() never allocates or touches the disk.
+//
+// Without an audio device (headless runs, BLASTFORGE_AUDIO=off) all of the
+// voice bookkeeping still runs, only the raylib calls are skipped.
+class AudioEngine {
+private:
+    struct Voice {
+        int      sound;     // -1 when idle
+        int      copy;
+        int      priority;
+        double   endTime;
+        unsigned serial;    // start order, for stealing the oldest
+    };
+
+    bool   device;
+    double clock;
+    unsigned serial;
+
+    std::vector<short> pcm[AUDIO_SOUNDS];     // generated samples
+    Sound  sounds[AUDIO_SOUNDS][AUDIO_COPIES];
+    int    copies[AUDIO_SOUNDS];
+    float  duration[AUDIO_SOUNDS];
+    int    priority[AUDIO_SOUNDS];
+    bool   loaded;
+
+    Voice  voices[AUDIO_VOICES];
+    int    played, stolen, dropped;
+
+    Music  music[2];            // one stream per BackgroundType
+    bool   hasMusic[2];
+    int    playingMusic;        // -1 when silent
+
+    void LoadEffect(SoundId id, const char* file, int nCopies, int prio);
+    void Retire();
+    bool CopyInUse(int sound, int copy) const;
+
+public:
+    AudioEngine();
+
+    void Init(bool useDevice);
+    void Unload();
+    void Update(double now);
+
+    // pan: 0 = left edge of the battlefield, 1 = right edge
+    bool Play(SoundId id, float pan = 0.5f);
+    void PlayMusic(BackgroundType bg);
+    void StopMusic();
+
+    int ActiveVoices() const;
+    int ActiveVoices(SoundId id) const;
+    int StolenVoices() const  { return stolen; }
+    int DroppedSounds() const { return dropped; }
+    void LogStats() const;
+};
+
+// Headless check of the voice pool with no audio device: a cluster burst
+// must stay inside AUDIO_VOICES and steal low priority voices first.
+// Run with "game --audio-check"; returns non-zero on failure.
+int RunAudioCheck();
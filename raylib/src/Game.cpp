@@ -1,5 +1,6 @@
 #include "Game.h"
 #include "Theme.h"
+#include "Rules.h"
 #include <cmath>
 #include <iostream>
 
@@ -24,9 +25,11 @@ void DrawCactus(int x, int y) {
 }
 
 static float GroundY(int screenH) {
-    return screenH - 80.0f;
+    return screenH - Rules::GroundDepth;
 }
 
+static const int MAX_STEPS = 12;   // per frame; beyond this a hitch is dropped, not replayed
+
 Game::Game(int W, int H)
     : w(W), h(H),
       state(GameState::Menu),
@@ -35,14 +38,22 @@ Game::Game(int W, int H)
       power{0.0f, 0.0f},
       paused(false),
       winner(-1),
-      wantQuit(false)
+      wantQuit(false),
+      held{},
+      simTime(0.0),
+      polledAt(0.0)
 {
 }
 
-void Game::Init() {
+Game::~Game() {
+    input.LogLatency();
+    audio.Unload();
+}
+
+void Game::Init(bool audioDevice) {
     float gy = GroundY(h);
-    tank[0].Init({ 150.0f, gy });
-    tank[1].Init({ (float)w - 150.0f, gy });
+    tank[0].Init({ Rules::TankInset, gy });
+    tank[1].Init({ (float)w - Rules::TankInset, gy });
 
     float cx = w / 2.0f;
 
@@ -60,102 +71,152 @@ void Game::Init() {
     btnResume = Button({ cx - 80.0f, h/2.0f + 40.0f, 160.0f, 40.0f }, "RESUME", 'C', KEY_C);
     
     btnExit   = Button({ cx - 60.0f, (float)h - 50.0f, 120.0f, 30.0f }, "EXIT", 'X', KEY_X);
+
+    audio.Init(audioDevice);
+
+    if (input.LoadBindings("bindings.cfg"))
+        TraceLog(LOG_INFO, "INPUT: loaded key bindings from bindings.cfg");
 }
 
 void Game::Reset() {
     float gy = GroundY(h);
-    tank[0].Init({ 150.0f, gy });
-    tank[1].Init({ (float)w - 150.0f, gy });
+    tank[0].Init({ Rules::TankInset, gy });
+    tank[1].Init({ (float)w - Rules::TankInset, gy });
     shots.clear();
     power[0] = 0.0f; power[1] = 0.0f;
     paused = false; winner = -1; turn = 0;
     state = GameState::Playing;
+    audio.PlayMusic(bg);
+    SyncInput();
+}
+
+void Game::ShowScene(GameState s, BackgroundType b) {
+    bg = b;
+    Reset();
+    state = s;
+    if (s == GameState::GameOver) {
+        // Player 1 wins the way a real match ends, by shooting player 2 down
+        while (!tank[1].IsDead()) tank[1].TakeDamage(Rules::HitDamage);
+        winner = 0;
+    }
+}
+
+bool Game::Clicked(const Button& b) {
+    if (!b.WasClicked()) return false;
+    audio.Play(SoundId::Click);
+    return true;
+}
+
+// Drop queued events and start the simulation from what is held right now,
+// used whenever the simulation hasn't been consuming the queue
+void Game::SyncInput() {
+    input.Flush();
+    for (int p = 0; p < INPUT_PLAYERS; ++p)
+        for (int a = 0; a < INPUT_ACTIONS; ++a)
+            held[p][a] = input.IsHeld(p, (InputAction)a);
+    simTime = GetTime();
 }
 
 // ---------------- UPDATE --------------------
-void Game::Update(float dt) {
+void Game::Update() {
+    if (polledAt <= 0.0) polledAt = GetTime();
+    input.Poll(polledAt);
+    audio.Update(GetTime());
     if (IsKeyPressed(KEY_H)) { wantQuit = true; return; }
 
     switch (state) {
         case GameState::Menu:             UpdateMenu();      break;
         case GameState::BackgroundSelect: UpdateBGSelect();  break;
-        case GameState::Playing:          UpdateGame(dt);    break;
+        case GameState::Playing:          UpdateGame();      break;
         case GameState::GameOver:         UpdateGameOver();  break;
     }
+    if (state != GameState::Playing || paused) SyncInput();
 }
 
 void Game::UpdateMenu() {
-    if (btnPlay.WasClicked()) state = GameState::BackgroundSelect;
-    if (btnExit.WasClicked()) wantQuit = true;
+    if (Clicked(btnPlay)) state = GameState::BackgroundSelect;
+    if (Clicked(btnExit)) wantQuit = true;
 }
 
 void Game::UpdateBGSelect() {
-    if (btnDesert.WasClicked()) { bg = BackgroundType::Desert; Reset(); }
-    if (btnMoon.WasClicked())   { bg = BackgroundType::MoonNight; Reset(); }
-    if (btnExit.WasClicked())   wantQuit = true;
+    if (Clicked(btnDesert)) { bg = BackgroundType::Desert; Reset(); }
+    if (Clicked(btnMoon))   { bg = BackgroundType::MoonNight; Reset(); }
+    if (Clicked(btnExit))   wantQuit = true;
 }
 
-void Game::UpdateGame(float dt) {
-    if (btnExit.WasClicked()) { wantQuit = true; return; }
-    if (btnPause.WasClicked()) paused = !paused;
+void Game::UpdateGame() {
+    if (Clicked(btnExit)) { wantQuit = true; return; }
+    if (Clicked(btnPause)) paused = !paused;
     if (paused) {
-        if (btnResume.WasClicked()) paused = false;
+        if (Clicked(btnResume)) paused = false;
         return;
     }
     
     // Toggle Theme Button
-    if (btnSwitchTheme.WasClicked()) {
+    if (Clicked(btnSwitchTheme)) {
         if (bg == BackgroundType::Desert) bg = BackgroundType::MoonNight;
         else bg = BackgroundType::Desert;
+        audio.PlayMusic(bg);
+    }
+
+    if (Clicked(btnRestart)) { Reset(); return; }
+
+    // Old behaviour, kept to compare against: fire sampled once per frame
+    if (input.IsLegacy() && input.LegacyFirePressed(turn)) Fire(input.LastPoll());
+
+    // Step the simulation up to the present. The last step may end slightly
+    // in the future so events polled this frame are applied this frame.
+    double now = GetTime();
+    int steps = 0;
+    while (simTime < now && steps < MAX_STEPS && state == GameState::Playing) {
+        Step(Rules::SimDt);
+        simTime += Rules::SimDt;
+        steps++;
     }
+    if (simTime < now) simTime = now;
+}
 
-    if (btnRestart.WasClicked()) { Reset(); return; }
+void Game::Step(float dt) {
+    InputEvent ev;
+    while (input.Pop(simTime + dt, ev)) {
+        held[ev.player][(int)ev.action] = ev.down;
+        if (ev.down && ev.action == InputAction::Fire && ev.player == turn) Fire(ev.time);
+    }
 
+    const bool* keys = held[turn];
     float& curPower = power[turn];
-    if (IsKeyDown(KEY_Q)) curPower -= dt * 0.5f;
-    if (IsKeyDown(KEY_E)) curPower += dt * 0.5f;
+    if (keys[(int)InputAction::PowerDown]) curPower -= dt * Rules::PowerRate;
+    if (keys[(int)InputAction::PowerUp])   curPower += dt * Rules::PowerRate;
     if (curPower < 0.0f) curPower = 0.0f;
     if (curPower > 1.0f) curPower = 1.0f;
 
-    const float BASE_SPEED = 300.0f;
-    const float POWER_MULT = 300.0f;
-
-    if (turn == 0) {
-        tank[0].Update(true, KEY_A, KEY_D, KEY_W, KEY_S, dt);
-        tank[1].Update(false, 0, 0, 0, 0, dt);
-
-        if (IsKeyPressed(KEY_SPACE)) {
-            float usedPower = (curPower < 0.1f) ? 0.1f : curPower;
-            Vector2 tip = tank[0].GetBarrelTip();
-            float ang   = tank[0].GetBarrelAngleRad();
-            float spd   = BASE_SPEED + POWER_MULT * usedPower;
-            
-            Projectile p;
-            p.Fire(tip, { cosf(ang)*spd, -sinf(ang)*spd }, WeaponType::Rocket, 0);
-            shots.push_back(p);
-            curPower = 0.0f; turn = 1;
-        }
-    } else {
-        tank[1].Update(true, KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, dt);
-        tank[0].Update(false, 0, 0, 0, 0, dt);
-
-        if (IsKeyPressed(KEY_ENTER)) {
-            float usedPower = (curPower < 0.1f) ? 0.1f : curPower;
-            Vector2 tip = tank[1].GetBarrelTip();
-            float ang   = tank[1].GetBarrelAngleRad();
-            float spd   = BASE_SPEED + POWER_MULT * usedPower;
-
-            Projectile p;
-            p.Fire(tip, { cosf(ang)*spd, -sinf(ang)*spd }, WeaponType::Rocket, 1);
-            shots.push_back(p);
-            curPower = 0.0f; turn = 0;
-        }
-    }
+    float move = (keys[(int)InputAction::MoveRight] ? 1.0f : 0.0f) - (keys[(int)InputAction::MoveLeft] ? 1.0f : 0.0f);
+    float aim  = (keys[(int)InputAction::AimUp]     ? 1.0f : 0.0f) - (keys[(int)InputAction::AimDown]  ? 1.0f : 0.0f);
+
+    tank[turn].Update(true, move, aim, dt);
+    tank[1 - turn].Update(false, 0.0f, 0.0f, dt);
 
     for (auto& s : shots) if (s.Active()) s.Update(dt);
     CheckCollisions();
 }
 
+void Game::Fire(double pressedAt) {
+    float& curPower = power[turn];
+    float usedPower = (curPower < Rules::MinPower) ? Rules::MinPower : curPower;
+    Vector2 tip = tank[turn].GetBarrelTip();
+    float ang   = tank[turn].GetBarrelAngleRad();
+    float spd   = Rules::BaseSpeed + Rules::PowerMult * usedPower;
+
+    Projectile p;
+    p.Fire(tip, { cosf(ang)*spd, -sinf(ang)*spd }, WeaponType::Rocket, turn);
+    shots.push_back(p);
+    input.RecordFire(pressedAt);
+    audio.Play(SoundId::Fire, tip.x / w);
+
+    curPower = 0.0f;
+    turn = 1 - turn;
+}
+
 void Game::CheckCollisions() {
     for (auto& s : shots) {
         if (!s.Active()) continue;
@@ -163,9 +224,11 @@ void Game::CheckCollisions() {
         int target = (owner == 0 ? 1 : 0);
 
         if (CheckCollisionRecs(s.GetRect(), tank[target].GetBody())) {
-            tank[target].TakeDamage(35);
+            tank[target].TakeDamage(Rules::HitDamage);
             s.Deactivate();
+            audio.Play(SoundId::Impact, s.GetRect().x / w);
             if (tank[target].IsDead()) {
+                audio.Play(SoundId::Explosion, tank[target].GetBody().x / w);
                 winner = owner;
                 state  = GameState::GameOver;
             }
@@ -248,13 +311,12 @@ void Game::DrawGame() {
     tank[1].Draw(p2C);
 
     // Trajectory
-    const float GRAVITY = 300.0f;
     Tank& active = (turn == 0 ? tank[0] : tank[1]);
-    float usedPower = (power[turn] < 0.1f) ? 0.1f : power[turn];
+    float usedPower = (power[turn] < Rules::MinPower) ? Rules::MinPower : power[turn];
 
     Vector2 start = active.GetBarrelTip();
     float   ang   = active.GetBarrelAngleRad();
-    float   speed = 300.0f + 300.0f * usedPower;
+    float   speed = Rules::BaseSpeed + Rules::PowerMult * usedPower;
     Vector2 v0    = { cosf(ang)*speed, -sinf(ang)*speed };
 
     // Trajectory matches player color
@@ -263,7 +325,7 @@ void Game::DrawGame() {
     for (int i = 0; i < 7; ++i) {
         float t = (0.6f + 0.2f * usedPower) * (float)i / 6.0f;
         float x = start.x + v0.x * t;
-        float y = start.y + v0.y * t + 0.5f * GRAVITY * t * t;
+        float y = start.y + v0.y * t + 0.5f * Rules::Gravity * t * t;
         if (y > gy) break;
         DrawCircleV({ x, y }, 3, arcColor);
     }
@@ -322,8 +384,8 @@ void Game::DrawGame() {
 }
 
 void Game::UpdateGameOver() {
-    if (btnRestart.WasClicked() || IsKeyPressed(KEY_R)) Reset();
-    if (btnExit.WasClicked()) wantQuit = true;
+    if (Clicked(btnRestart) || IsKeyPressed(KEY_R)) Reset();
+    if (Clicked(btnExit)) wantQuit = true;
 }
 
 void Game::DrawGameOver() {
@@ -5,6 +5,8 @@
 #include "Projectile.h"
 #include "Button.h"
 #include "Types.h"
+#include "Input.h"
+#include "Audio.h"
 
 class Game {
 private:
@@ -32,11 +34,23 @@ private:
     int   winner;
     bool  wantQuit;     
 
+    // Fixed-step simulation fed by the input queue
+    Input  input;
+    bool   held[INPUT_PLAYERS][INPUT_ACTIONS]; // as seen by the simulation
+    double simTime;
+    double polledAt;    // when raylib last polled input, see Presented()
+
+    AudioEngine audio;
+
     void Reset();
+    bool Clicked(const Button& b);
+    void SyncInput();
     void UpdateMenu();
     void UpdateBGSelect();
-    void UpdateGame(float dt);
+    void UpdateGame();
     void UpdateGameOver();
+    void Step(float dt);
+    void Fire(double pressedAt);
     void CheckCollisions();
 
     void DrawMenu();
@@ -46,9 +60,18 @@ private:
 
 public:
     Game(int W, int H);
-    void Init();
-    void Update(float dt);
+    ~Game();
+    void Init(bool audioDevice);
+    void Update();
     void Draw();
 
     bool ShouldQuit() const { return wantQuit; }
+
+    // Call right after EndDrawing() with target FPS 0, before any pacing
+    // wait. raylib polls input there too, so this is also the poll time.
+    void Presented(double now) { input.Presented(now); polledAt = now; }
+    void SetLegacyInput(bool v) { input.SetLegacy(v); }
+
+    // Puts the game in a fixed, repeatable state for offscreen rendering
+    void ShowScene(GameState s, BackgroundType b);
 };
\ No newline at end of file
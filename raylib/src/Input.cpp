@@ -0,0 +1,233 @@
+#include "Input.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+static const char* ACTION_NAMES[INPUT_ACTIONS] = {
+    "move_left", "move_right", "aim_up", "aim_down", "power_down", "power_up", "fire"
+};
+
+static const float AXIS_DEADZONE = 0.5f;
+
+Input::Input()
+    : head(0), count(0),
+      tapCount(0), lastPoll(0.0),
+      legacy(false), legacyFire{ false, false }, lostTaps(0),
+      pendingCount(0),
+      fireCount(0), fireTotal(0.0), fireMax(0.0)
+{
+    for (int p = 0; p < INPUT_PLAYERS; ++p)
+        for (int a = 0; a < INPUT_ACTIONS; ++a)
+            held[p][a] = false;
+    SetDefaults();
+}
+
+void Input::SetDefaults() {
+    for (int p = 0; p < INPUT_PLAYERS; ++p)
+        for (int a = 0; a < INPUT_ACTIONS; ++a)
+            bind[p][a] = { { KEY_NULL, KEY_NULL }, GAMEPAD_BUTTON_UNKNOWN, -1, 0.0f };
+
+    // Player 1: left side of the keyboard
+    Bind(0, InputAction::MoveLeft,  KEY_A);
+    Bind(0, InputAction::MoveRight, KEY_D);
+    Bind(0, InputAction::AimUp,     KEY_W);
+    Bind(0, InputAction::AimDown,   KEY_S);
+    Bind(0, InputAction::PowerDown, KEY_Q);
+    Bind(0, InputAction::PowerUp,   KEY_E);
+    Bind(0, InputAction::Fire,      KEY_SPACE);
+
+    // Player 2: arrows, brackets / keypad for power
+    Bind(1, InputAction::MoveLeft,  KEY_LEFT);
+    Bind(1, InputAction::MoveRight, KEY_RIGHT);
+    Bind(1, InputAction::AimUp,     KEY_UP);
+    Bind(1, InputAction::AimDown,   KEY_DOWN);
+    Bind(1, InputAction::PowerDown, KEY_LEFT_BRACKET);
+    Bind(1, InputAction::PowerDown, KEY_KP_SUBTRACT, 1);
+    Bind(1, InputAction::PowerUp,   KEY_RIGHT_BRACKET);
+    Bind(1, InputAction::PowerUp,   KEY_KP_ADD, 1);
+    Bind(1, InputAction::Fire,      KEY_ENTER);
+    Bind(1, InputAction::Fire,      KEY_KP_ENTER, 1);
+
+    // Same layout on both gamepads
+    for (int p = 0; p < INPUT_PLAYERS; ++p) {
+        BindPad(p, InputAction::MoveLeft,  GAMEPAD_BUTTON_LEFT_FACE_LEFT);
+        BindPad(p, InputAction::MoveRight, GAMEPAD_BUTTON_LEFT_FACE_RIGHT);
+        BindPad(p, InputAction::AimUp,     GAMEPAD_BUTTON_LEFT_FACE_UP);
+        BindPad(p, InputAction::AimDown,   GAMEPAD_BUTTON_LEFT_FACE_DOWN);
+        BindPad(p, InputAction::PowerDown, GAMEPAD_BUTTON_LEFT_TRIGGER_1);
+        BindPad(p, InputAction::PowerUp,   GAMEPAD_BUTTON_RIGHT_TRIGGER_1);
+        BindPad(p, InputAction::Fire,      GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
+
+        bind[p][(int)InputAction::MoveLeft].padAxis  = GAMEPAD_AXIS_LEFT_X;
+        bind[p][(int)InputAction::MoveLeft].padSign  = -1.0f;
+        bind[p][(int)InputAction::MoveRight].padAxis = GAMEPAD_AXIS_LEFT_X;
+        bind[p][(int)InputAction::MoveRight].padSign = 1.0f;
+        bind[p][(int)InputAction::AimUp].padAxis     = GAMEPAD_AXIS_LEFT_Y;
+        bind[p][(int)InputAction::AimUp].padSign     = -1.0f;
+        bind[p][(int)InputAction::AimDown].padAxis   = GAMEPAD_AXIS_LEFT_Y;
+        bind[p][(int)InputAction::AimDown].padSign   = 1.0f;
+    }
+}
+
+void Input::Bind(int player, InputAction a, int key, int slot) {
+    bind[player][(int)a].keys[slot] = key;
+}
+
+void Input::BindPad(int player, InputAction a, int button) {
+    bind[player][(int)a].padButton = button;
+}
+
+// One binding per line: "<player 1|2> <action> key|pad <raylib code>"
+// e.g. "2 power_up key 93". Lines starting with '#' are ignored.
+bool Input::LoadBindings(const char* path) {
+    ifstream in(path);
+    if (!in) return false;
+
+    bool remapped[INPUT_PLAYERS][INPUT_ACTIONS] = {};
+    string line;
+    int lineNo = 0;
+    while (getline(in, line)) {
+        lineNo++;
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream ss(line);
+        int player = 0, code = 0;
+        string action, kind;
+        if (!(ss >> player >> action >> kind >> code) || player < 1 || player > INPUT_PLAYERS) {
+            TraceLog(LOG_WARNING, "INPUT: %s:%d: malformed binding", path, lineNo);
+            continue;
+        }
+
+        int a = 0;
+        while (a < INPUT_ACTIONS && action != ACTION_NAMES[a]) a++;
+        if (a == INPUT_ACTIONS) {
+            TraceLog(LOG_WARNING, "INPUT: %s:%d: unknown action '%s'", path, lineNo, action.c_str());
+            continue;
+        }
+
+        // The first key line for an action replaces the defaults, a second
+        // one adds an alternative key
+        InputBinding& b = bind[player - 1][a];
+        if (kind == "key") {
+            if (!remapped[player - 1][a]) b.keys[1] = KEY_NULL;
+            b.keys[remapped[player - 1][a] ? 1 : 0] = code;
+            remapped[player - 1][a] = true;
+        } else if (kind == "pad") {
+            b.padButton = code;
+        } else {
+            TraceLog(LOG_WARNING, "INPUT: %s:%d: expected 'key' or 'pad'", path, lineNo);
+        }
+    }
+    return true;
+}
+
+bool Input::IsBindingDown(int player, const InputBinding& b) const {
+    for (int k : b.keys)
+        if (k != KEY_NULL && IsKeyDown(k)) return true;
+
+    if (!IsGamepadAvailable(player)) return false;
+    if (b.padButton != GAMEPAD_BUTTON_UNKNOWN && IsGamepadButtonDown(player, b.padButton)) return true;
+    if (b.padAxis >= 0 && GetGamepadAxisMovement(player, b.padAxis) * b.padSign > AXIS_DEADZONE) return true;
+    return false;
+}
+
+// From raylib's press queue, which keeps keys that went down and back up
+// before the frame's poll; IsKeyPressed() only sees keys still down
+bool Input::WasBindingTapped(const InputBinding& b) const {
+    for (int i = 0; i < tapCount; ++i)
+        for (int k : b.keys)
+            if (k != KEY_NULL && taps[i] == k) return true;
+    return false;
+}
+
+// What the old frame-sampled code saw
+bool Input::WasBindingPressed(int player, const InputBinding& b) const {
+    for (int k : b.keys)
+        if (k != KEY_NULL && IsKeyPressed(k)) return true;
+    if (!IsGamepadAvailable(player)) return false;
+    return b.padButton != GAMEPAD_BUTTON_UNKNOWN && IsGamepadButtonPressed(player, b.padButton);
+}
+
+void Input::Push(double time, int player, InputAction a, bool down) {
+    if (count == INPUT_QUEUE) {
+        TraceLog(LOG_WARNING, "INPUT: event queue full, dropping event");
+        return;
+    }
+    queue[(head + count) % INPUT_QUEUE] = { time, player, a, down };
+    count++;
+}
+
+void Input::Poll(double now) {
+    lastPoll = now;
+    tapCount = 0;
+    for (int k = GetKeyPressed(); k != 0; k = GetKeyPressed())
+        if (tapCount < INPUT_TAPS) taps[tapCount++] = k;
+
+    for (int p = 0; p < INPUT_PLAYERS; ++p) {
+        const InputBinding& fire = bind[p][(int)InputAction::Fire];
+        legacyFire[p] = WasBindingPressed(p, fire);
+        if (WasBindingTapped(fire) && !legacyFire[p]) lostTaps++;
+
+        for (int a = 0; a < INPUT_ACTIONS; ++a) {
+            InputAction act = (InputAction)a;
+            if (legacy && act == InputAction::Fire) continue;
+
+            bool down   = IsBindingDown(p, bind[p][a]);
+            bool tapped = WasBindingTapped(bind[p][a]);
+            bool was    = held[p][a];
+
+            if (tapped) {
+                // A fresh press, even if it was released again or followed
+                // a release we never saw
+                if (was) Push(now, p, act, false);
+                Push(now, p, act, true);
+                if (!down) Push(now, p, act, false);
+            } else if (down != was) {
+                Push(now, p, act, down);
+            }
+            held[p][a] = down;
+        }
+    }
+}
+
+bool Input::Pop(double until, InputEvent& out) {
+    if (count == 0 || queue[head].time > until) return false;
+    out  = queue[head];
+    head = (head + 1) % INPUT_QUEUE;
+    count--;
+    return true;
+}
+
+void Input::Flush() {
+    head = 0;
+    count = 0;
+}
+
+bool Input::IsHeld(int player, InputAction a) const {
+    return held[player][(int)a];
+}
+
+void Input::RecordFire(double eventTime) {
+    if (pendingCount < INPUT_QUEUE) firePending[pendingCount++] = eventTime;
+}
+
+void Input::Presented(double now) {
+    for (int i = 0; i < pendingCount; ++i) {
+        double lat = now - firePending[i];
+        fireCount++;
+        fireTotal += lat;
+        if (lat > fireMax) fireMax = lat;
+    }
+    pendingCount = 0;
+}
+
+void Input::LogLatency() const {
+    const char* mode = legacy ? "frame-sampled (legacy)" : "event queue";
+    if (fireCount > 0)
+        TraceLog(LOG_INFO, "INPUT: %s poll-to-present time over %d shots: avg %.2f ms, max %.2f ms",
+                 mode, fireCount, fireTotal / fireCount * 1000.0, fireMax * 1000.0);
+    TraceLog(LOG_INFO, "INPUT: %d fire taps were shorter than a frame%s", lostTaps,
+             legacy ? " and were lost" : " (kept by the event queue)");
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "raylib.h"
+#include "Types.h"
+
+static const int INPUT_PLAYERS = 2;
+static const int INPUT_ACTIONS = (int)InputAction::Count;
+static const int INPUT_QUEUE   = 256;
+static const int INPUT_TAPS    = 32;   // key presses remembered per poll
+
+// A press or release of one action, stamped with the time it was polled
+struct InputEvent {
+    double      time;
+    int         player;
+    InputAction action;
+    bool        down;
+};
+
+struct InputBinding {
+    int   keys[2];      // KEY_NULL when unused
+    int   padButton;    // GAMEPAD_BUTTON_UNKNOWN when unused
+    int   padAxis;      // -1 when unused
+    float padSign;      // which half of the axis counts as pressed
+};
+
+// Drains raylib input once per frame into a queue of timestamped events that
+// the fixed-step simulation consumes, so no press is missed or doubled when
+// the frame rate hitches. Player N also reads gamepad N when it is present.
+//
+// Legacy mode keeps the old frame-sampled IsKeyPressed() fire check, so its
+// latency and lost taps can be compared against the queue.
+class Input {
+private:
+    InputBinding bind[INPUT_PLAYERS][INPUT_ACTIONS];
+    bool         held[INPUT_PLAYERS][INPUT_ACTIONS];
+
+    InputEvent queue[INPUT_QUEUE];  // ring buffer
+    int        head, count;
+
+    int    taps[INPUT_TAPS];        // raylib's key press queue, this poll
+    int    tapCount;
+    double lastPoll;
+
+    bool   legacy;
+    bool   legacyFire[INPUT_PLAYERS];
+    int    lostTaps;                // fire taps frame sampling would not see
+
+    // Input-to-fire latency: poll to the first presented frame, in seconds
+    double firePending[INPUT_QUEUE];
+    int    pendingCount;
+    int    fireCount;
+    double fireTotal, fireMax;
+
+    bool IsBindingDown(int player, const InputBinding& b) const;
+    bool WasBindingTapped(const InputBinding& b) const;
+    bool WasBindingPressed(int player, const InputBinding& b) const;
+    void Push(double time, int player, InputAction a, bool down);
+
+public:
+    Input();
+
+    void SetDefaults();
+    void Bind(int player, InputAction a, int key, int slot = 0);
+    void BindPad(int player, InputAction a, int button);
+    bool LoadBindings(const char* path);
+
+    void Poll(double now);
+    bool Pop(double until, InputEvent& out); // oldest event stamped <= until
+    void Flush();
+
+    bool IsHeld(int player, InputAction a) const;
+
+    void   SetLegacy(bool v) { legacy = v; }
+    bool   IsLegacy() const  { return legacy; }
+    bool   LegacyFirePressed(int player) const { return legacyFire[player]; }
+    double LastPoll() const  { return lastPoll; }
+
+    void RecordFire(double eventTime);
+    void Presented(double now); // after the buffer swap: shots fired so far are on screen
+    void LogLatency() const;
+};
@@ -0,0 +1,251 @@
+#include "Ladder.h"
+#include "Match.h"
+#include "MatchLog.h"
+#include "Rating.h"
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+static const uint32_t CHUNK = 64;   // matches a worker claims at a time
+
+// Names accepted by --ladder-query-weapon
+static const struct { const char* name; WeaponType type; } WEAPON_NAMES[] = {
+    { "rocket", WeaponType::Rocket },
+};
+
+// Built-in opponents, from sharpshooter to hopeless
+static vector<Strategy> DefaultStrategies() {
+    return {
+        { "Sniper",   45.0f, 1.0f, 0.02f, 0.9f, {} },
+        { "Gunner",   40.0f, 3.0f, 0.05f, 0.6f, {} },
+        { "Lobber",   65.0f, 2.0f, 0.04f, 0.7f, {} },
+        { "Stubborn", 45.0f, 2.0f, 0.04f, 0.0f, {} },
+        { "Rookie",   50.0f, 8.0f, 0.15f, 0.3f, {} },
+    };
+}
+
+static void PrintStandings(const MatchLog& log, const vector<Rating>& ratings) {
+    vector<size_t> order;
+    for (size_t i = 0; i < ratings.size(); ++i)
+        if (ratings[i].Games() > 0) order.push_back(i);
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ratings[a].elo > ratings[b].elo; });
+
+    printf("%-4s %-20s %7s %13s %8s %8s %8s\n", "#", "PLAYER", "ELO", "GLICKO", "WINS", "LOSSES", "DRAWS");
+    int rank = 1;
+    for (size_t i : order) {
+        const Rating& r = ratings[i];
+        printf("%-4d %-20s %7.0f %7.0f +-%3.0f %8d %8d %8d\n", rank++, log.Players()[i].c_str(),
+               r.elo, r.glicko, r.rd, r.wins, r.losses, r.draws);
+    }
+}
+
+static double Score(const MatchResult& r) {
+    return (r.winner == 0) ? 1.0 : (r.winner == 1 ? 0.0 : 0.5);
+}
+
+static int Query(const MatchLog& log, const char* name) {
+    const vector<string>& names = log.Players();
+    auto it = find(names.begin(), names.end(), string(name));
+    if (it == names.end()) {
+        fprintf(stderr, "No player named '%s' in the ladder log\n", name);
+        return 1;
+    }
+    uint16_t id = (uint16_t)(it - names.begin());
+
+    // Per-opponent record straight from the player index
+    vector<int> wins(names.size(), 0), losses(names.size(), 0), draws(names.size(), 0);
+    vector<MatchResult> games = log.Read(log.PlayerIndex(id));
+    for (const MatchResult& r : games) {
+        bool first = (r.p0 == id);
+        uint16_t opp = first ? r.p1 : r.p0;
+        if (r.winner < 0)                   draws[opp]++;
+        else if ((r.winner == 0) == first)  wins[opp]++;
+        else                                losses[opp]++;
+    }
+
+    printf("%s: %zu matches\n", name, games.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (wins[i] + losses[i] + draws[i] == 0) continue;
+        printf("  vs %-20s %6d W %6d L %6d D\n", names[i].c_str(), wins[i], losses[i], draws[i]);
+    }
+    return 0;
+}
+
+static int QueryWeapon(const MatchLog& log, const char* name) {
+    string key = name;
+    for (char& c : key) c = (char)tolower((unsigned char)c);
+    const WeaponType* weapon = nullptr;
+    for (const auto& w : WEAPON_NAMES)
+        if (key == w.name) weapon = &w.type;
+    if (!weapon) {
+        fprintf(stderr, "Unknown weapon '%s'\n", name);
+        return 1;
+    }
+
+    // Per-player record and match length straight from the weapon index
+    const vector<string>& names = log.Players();
+    vector<int> wins(names.size(), 0), losses(names.size(), 0), draws(names.size(), 0);
+    vector<double> turns(names.size(), 0.0);
+    vector<MatchResult> games = log.Read(log.WeaponIndex(*weapon));
+    for (const MatchResult& r : games) {
+        uint16_t side[2] = { r.p0, r.p1 };
+        for (int s = 0; s < 2; ++s) {
+            if (s == 1 && r.p1 == r.p0) break;
+            if (r.winner < 0)       draws[side[s]]++;
+            else if (r.winner == s) wins[side[s]]++;
+            else                    losses[side[s]]++;
+            turns[side[s]] += r.turns;
+        }
+    }
+
+    printf("%s: %zu matches\n", key.c_str(), games.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        int played = wins[i] + losses[i] + draws[i];
+        if (played == 0) continue;
+        printf("  %-20s %6d W %6d L %6d D %7.1f turns/match\n", names[i].c_str(),
+               wins[i], losses[i], draws[i], turns[i] / played);
+    }
+    return 0;
+}
+
+int RunLadder(int argc, char** argv) {
+    uint32_t total   = 0;
+    int      threads = (int)thread::hardware_concurrency();
+    string   path    = "ladder";
+    const char* query = nullptr;
+    const char* weaponQuery = nullptr;
+    vector<Strategy> roster = DefaultStrategies();
+
+    for (int i = 1; i < argc; ++i) {
+        bool more = (i + 1 < argc);
+        if      (!strcmp(argv[i], "--ladder") && more)       total = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--ladder-query") && more) query = argv[++i];
+        else if (!strcmp(argv[i], "--ladder-query-weapon") && more) weaponQuery = argv[++i];
+        else if (!strcmp(argv[i], "--threads") && more)      threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--log") && more)          path = argv[++i];
+        else if (!strcmp(argv[i], "--script") && more) {
+            Strategy s;
+            if (!Strategy::LoadScript(argv[++i], s)) {
+                fprintf(stderr, "Cannot read strategy script %s\n", argv[i]);
+                return 1;
+            }
+            roster.push_back(s);
+        }
+    }
+    if (threads < 1) threads = 1;
+
+    MatchLog log;
+    if (query || weaponQuery) {
+        if (!log.OpenReadOnly(path)) return 1;
+        return query ? Query(log, query) : QueryWeapon(log, weaponQuery);
+    }
+
+    vector<Rating> ratings;
+    if (!log.Open(path)) return 1;
+
+    // Ratings are never stored, the log replays them
+    bool ok = log.Scan([&](const MatchResult& r) {
+        size_t need = max(r.p0, r.p1) + 1u;
+        if (ratings.size() < need) ratings.resize(need);
+        UpdateRatings(ratings[r.p0], ratings[r.p1], Score(r));
+    });
+    if (!ok) return 1;
+
+    vector<uint16_t> ids;
+    for (const Strategy& s : roster) ids.push_back(log.PlayerId(s.name));
+    ratings.resize(log.Players().size());
+
+    vector<pair<int, int>> pairs;
+    for (size_t a = 0; a < roster.size(); ++a)
+        for (size_t b = a + 1; b < roster.size(); ++b)
+            pairs.push_back({ (int)a, (int)b });
+
+    const uint32_t firstId = log.Count();
+    const uint32_t window  = CHUNK * (uint32_t)threads * 4;
+
+    // Workers fill a bounded window of result slots; this thread drains it in
+    // match order, so ratings come out the same for any thread count
+    vector<MatchResult> slots(window);
+    vector<char>        ready(window, 0);
+    uint32_t            applied = 0;
+    atomic<uint32_t>    nextMatch(0);
+    mutex               mtx;
+    condition_variable  haveResults, haveSpace;
+
+    auto worker = [&]() {
+        MatchResult local[CHUNK];
+        for (;;) {
+            uint32_t start = nextMatch.fetch_add(CHUNK);
+            if (start >= total) return;
+            uint32_t end = min(start + CHUNK, total);
+            {
+                unique_lock<mutex> lock(mtx);
+                haveSpace.wait(lock, [&] { return end <= applied + window; });
+            }
+            for (uint32_t k = start; k < end; ++k) {
+                // Each pair plays twice per round, swapping who shoots first
+                const pair<int, int>& pr = pairs[(k / 2) % pairs.size()];
+                int a = (k % 2 == 0) ? pr.first : pr.second;
+                int b = (k % 2 == 0) ? pr.second : pr.first;
+
+                uint32_t id = firstId + k;
+                Match m(id * 2654435761u + 1u);
+                local[k - start] = m.Play(roster[a], roster[b], ids[a], ids[b]);
+                local[k - start].id = id;
+            }
+            {
+                lock_guard<mutex> lock(mtx);
+                for (uint32_t k = start; k < end; ++k) {
+                    slots[k % window] = local[k - start];
+                    ready[k % window] = 1;
+                }
+            }
+            haveResults.notify_one();
+        }
+    };
+
+    if (pairs.empty()) total = 0;
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int i = 0; i < threads && total > 0; ++i) pool.emplace_back(worker);
+
+    vector<MatchResult> batch;
+    batch.reserve(window);
+    while (applied < total) {
+        {
+            unique_lock<mutex> lock(mtx);
+            haveResults.wait(lock, [&] { return ready[applied % window] != 0; });
+            batch.clear();
+            while (applied < total && ready[applied % window]) {
+                batch.push_back(slots[applied % window]);
+                ready[applied % window] = 0;
+                applied++;
+            }
+        }
+        haveSpace.notify_all();
+
+        for (const MatchResult& r : batch) {
+            log.Append(r);
+            UpdateRatings(ratings[r.p0], ratings[r.p1], Score(r));
+        }
+    }
+    for (thread& t : pool) t.join();
+    log.Flush();
+
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    printf("Played %u matches on %d threads in %.2f s (%.0f matches/s), %u in the log\n\n",
+           total, threads, secs, secs > 0.0 ? total / secs : 0.0, log.Count());
+    PrintStandings(log, ratings);
+    return 0;
+}
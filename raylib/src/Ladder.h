@@ -0,0 +1,14 @@
+#pragma once
+
+// Headless round-robin ladder between AI configurations and recorded
+// strategies, run from the command line with no window:
+//
+//   game --ladder <matches> [--threads N] [--log PATH] [--script FILE]...
+//   game --ladder-query <player> [--log PATH]
+//   game --ladder-query-weapon <weapon> [--log PATH]
+//
+// Results stream into an append-only MatchLog; Elo/Glicko ratings are
+// rebuilt from the log, so repeated runs keep climbing the same ladder.
+// Queries open the log read-only and go through its on-disk player and
+// weapon indexes, no full scan.
+int RunLadder(int argc, char** argv);
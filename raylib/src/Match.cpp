@@ -0,0 +1,131 @@
+#include "Match.h"
+#include "Tank.h"
+#include "Projectile.h"
+#include "Rules.h"
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+static const int   MAX_TURNS     = 60;      // after this the match is a draw
+static const float AIM_TOLERANCE = 0.5f;    // degrees
+static const float MAX_FLIGHT    = 10.0f;   // seconds
+
+// Text file: first line is the player name, then one "angle power" per line
+bool Strategy::LoadScript(const char* path, Strategy& out) {
+    ifstream in(path);
+    if (!in || !getline(in, out.name) || out.name.empty()) return false;
+
+    out.angle = 45.0f; out.aimError = 0.0f; out.powerError = 0.0f; out.learnRate = 0.0f;
+    out.script.clear();
+
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream ss(line);
+        Shot s;
+        if (ss >> s.angle >> s.power) out.script.push_back(s);
+    }
+    return !out.script.empty();
+}
+
+Match::Match(uint32_t Seed, int W, int H)
+    : seed(Seed), w(W), h(H)
+{
+}
+
+// Power that lands a shot at 'dist' on flat ground for the given angle
+static float IdealPower(float dist, float angleDeg) {
+    if (dist < 1.0f) dist = 1.0f;
+    float s2 = sinf(2.0f * angleDeg * 3.14159265f / 180.0f);
+    if (s2 < 0.05f) s2 = 0.05f;
+    float speed = sqrtf(Rules::Gravity * dist / s2);
+    return (speed - Rules::BaseSpeed) / Rules::PowerMult;
+}
+
+MatchResult Match::Play(const Strategy& s0, const Strategy& s1, uint16_t id0, uint16_t id1) {
+    const Strategy* strat[2] = { &s0, &s1 };
+    mt19937 rng(seed);
+    normal_distribution<float> noise(0.0f, 1.0f);
+
+    float gy = h - Rules::GroundDepth;
+    Tank tank[2];
+    tank[0].Init({ Rules::TankInset, gy });
+    tank[1].Init({ (float)w - Rules::TankInset, gy });
+
+    // Per-player aim state: where the next shot goes, and which script line
+    float nextAngle[2], nextPower[2];
+    size_t scriptPos[2] = { 0, 0 };
+    for (int p = 0; p < 2; ++p) {
+        float dist = fabsf(tank[1].GetBody().x - tank[0].GetBody().x);
+        nextAngle[p] = strat[p]->angle;
+        nextPower[p] = IdealPower(dist, nextAngle[p]);
+    }
+
+    MatchResult r = { 0, id0, id1, -1, WeaponType::Rocket, 0 };
+    int turn = 0;
+
+    for (int t = 0; t < MAX_TURNS; ++t) {
+        const Strategy& st = *strat[turn];
+        Tank& me = tank[turn];
+        Tank& enemy = tank[1 - turn];
+
+        float angle, power;
+        if (!st.script.empty()) {
+            const Shot& s = st.script[scriptPos[turn]++ % st.script.size()];
+            angle = s.angle; power = s.power;
+        } else {
+            angle = nextAngle[turn] + noise(rng) * st.aimError;
+            power = nextPower[turn] + noise(rng) * st.powerError;
+        }
+        if (power < Rules::MinPower) power = Rules::MinPower;
+        if (power > 1.0f) power = 1.0f;
+
+        // Player 2 faces left, so its barrel angle is mirrored
+        float barrel = (turn == 0) ? angle : 180.0f - angle;
+
+        // Traverse the barrel with the same controls a human would use
+        float deg = me.GetBarrelAngleRad() * 180.0f / 3.14159265f;
+        for (int i = 0; i < 1000 && fabsf(deg - barrel) > AIM_TOLERANCE; ++i) {
+            me.Update(true, 0.0f, (barrel > deg) ? 1.0f : -1.0f, Rules::SimDt);
+            float now = me.GetBarrelAngleRad() * 180.0f / 3.14159265f;
+            if (now == deg) break; // against the stop
+            deg = now;
+        }
+
+        float ang = me.GetBarrelAngleRad();
+        float spd = Rules::BaseSpeed + Rules::PowerMult * power;
+        Projectile shot;
+        shot.Fire(me.GetBarrelTip(), { cosf(ang)*spd, -sinf(ang)*spd }, WeaponType::Rocket, turn);
+
+        // Fly until it hits the enemy or drops below the ground line
+        bool hit = false;
+        float landX = 0.0f;
+        for (float f = 0.0f; f < MAX_FLIGHT && shot.Active(); f += Rules::SimDt) {
+            shot.Update(Rules::SimDt);
+            Rectangle pr = shot.GetRect();
+            if (CheckCollisionRecs(pr, enemy.GetBody())) { hit = true; break; }
+            landX = pr.x + pr.width / 2.0f;
+            if (pr.y + pr.height / 2.0f > gy) break;
+        }
+
+        r.turns++;
+        if (hit) {
+            enemy.TakeDamage(Rules::HitDamage);
+            if (enemy.IsDead()) { r.winner = (int8_t)turn; break; }
+        } else if (st.script.empty()) {
+            // Move towards the power that would have closed the gap between
+            // where this shot landed and the enemy
+            Rectangle eb = enemy.GetBody();
+            float target = eb.x + eb.width / 2.0f;
+            float dist   = fabsf(target - (me.GetBody().x + me.GetBody().width / 2.0f));
+            float short_ = (turn == 0) ? (target - landX) : (landX - target);
+            float wanted = power + IdealPower(dist, angle) - IdealPower(dist - short_, angle);
+            nextPower[turn] += st.learnRate * (wanted - nextPower[turn]);
+        }
+        turn = 1 - turn;
+    }
+    return r;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Types.h"
+
+// One recorded shot, from the shooter's point of view (angle 0 = towards
+// the enemy along the ground, 90 = straight up)
+struct Shot {
+    float angle;
+    float power;
+};
+
+// How a ladder player aims. Built-in AIs aim at the enemy with some noise and
+// correct from where their last shot landed; a non-empty script instead
+// replays recorded shots in a loop.
+struct Strategy {
+    std::string name;
+    float angle;        // preferred launch angle, degrees
+    float aimError;     // angle noise (std dev), degrees
+    float powerError;   // power noise (std dev)
+    float learnRate;    // 0 = ignore misses, 1 = fully correct from the last miss
+    std::vector<Shot> script;
+
+    static bool LoadScript(const char* path, Strategy& out);
+};
+
+struct MatchResult {
+    uint32_t   id;
+    uint16_t   p0, p1;
+    int8_t     winner;      // 0 / 1, or -1 for a draw
+    WeaponType weapon;
+    uint16_t   turns;
+};
+
+// A full match played on the headless simulation: same tanks, projectiles
+// and rules as the game, stepped at the game's fixed rate, no window needed.
+class Match {
+private:
+    uint32_t seed;
+    int      w, h;
+
+public:
+    Match(uint32_t Seed, int W = 1280, int H = 720);
+
+    MatchResult Play(const Strategy& s0, const Strategy& s1, uint16_t id0, uint16_t id1);
+};
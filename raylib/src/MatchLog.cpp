@@ -0,0 +1,311 @@
+#include "MatchLog.h"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+static const char     MAGIC[8]      = { 'B', 'F', 'L', 'A', 'D', 'D', 'R', '1' };
+static const uint32_t RECORD_SIZE   = 12;
+static const uint32_t FLUSH_RECORDS = 4096;   // records per block write
+static const int      MAX_WEAPONS   = 256;    // weapon ids fit in one byte
+
+// Fixed little-endian layout so logs move between machines
+static void Encode(const MatchResult& r, unsigned char* b) {
+    b[0] = r.id & 0xFF; b[1] = (r.id >> 8) & 0xFF; b[2] = (r.id >> 16) & 0xFF; b[3] = (r.id >> 24) & 0xFF;
+    b[4] = r.p0 & 0xFF; b[5] = r.p0 >> 8;
+    b[6] = r.p1 & 0xFF; b[7] = r.p1 >> 8;
+    b[8] = (unsigned char)r.winner;
+    b[9] = (unsigned char)r.weapon;
+    b[10] = r.turns & 0xFF; b[11] = r.turns >> 8;
+}
+
+static MatchResult Decode(const unsigned char* b) {
+    MatchResult r;
+    r.id     = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+    r.p0     = (uint16_t)(b[4] | (b[5] << 8));
+    r.p1     = (uint16_t)(b[6] | (b[7] << 8));
+    r.winner = (int8_t)b[8];
+    r.weapon = (WeaponType)b[9];
+    r.turns  = (uint16_t)(b[10] | (b[11] << 8));
+    return r;
+}
+
+static void PutU32(vector<unsigned char>& out, uint32_t v) {
+    out.push_back(v & 0xFF); out.push_back((v >> 8) & 0xFF);
+    out.push_back((v >> 16) & 0xFF); out.push_back((v >> 24) & 0xFF);
+}
+
+static uint32_t GetU32(const unsigned char* b) {
+    return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static uint64_t FileSize(const string& path) {
+    ifstream in(path, ios::binary | ios::ate);
+    return in ? (uint64_t)in.tellg() : 0;
+}
+
+MatchLog::MatchLog()
+    : count(0),
+      indexFiles(true)
+{
+}
+
+MatchLog::~MatchLog() {
+    if (matchesOut.is_open()) Flush();
+}
+
+string MatchLog::IndexPath(char kind, size_t id) const {
+    return base + "." + kind + to_string(id) + ".idx";
+}
+
+// Players and the number of whole records; changes nothing on disk
+bool MatchLog::Load(const string& path) {
+    base = path;
+    players.clear(); pending.clear();
+    pendingByPlayer.clear(); pendingByWeapon.clear();
+    count = 0;
+    indexFiles = true;
+
+    ifstream pin(base + ".players");
+    string name;
+    while (getline(pin, name)) players.push_back(name);
+    pendingByPlayer.resize(players.size());
+    pendingByWeapon.resize(MAX_WEAPONS);
+
+    string matchesPath = base + ".matches";
+    if (!FileExists(matchesPath.c_str())) return true;
+
+    ifstream in(matchesPath, ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(MAGIC)) || !equal(magic, magic + sizeof(MAGIC), MAGIC)) {
+        TraceLog(LOG_ERROR, "LADDER: %s is not a ladder log", matchesPath.c_str());
+        return false;
+    }
+    count = (uint32_t)((FileSize(matchesPath) - sizeof(MAGIC)) / RECORD_SIZE);
+    return true;
+}
+
+bool MatchLog::IndexesCoverLog() const {
+    ifstream cov(base + ".idx", ios::binary);
+    unsigned char cb[4];
+    return cov.read((char*)cb, 4) && GetU32(cb) == count;
+}
+
+bool MatchLog::Open(const string& path) {
+    string matchesPath = path + ".matches";
+    bool fresh = !FileExists(matchesPath.c_str());
+    if (!Load(path)) return false;
+
+    if (!fresh && FileSize(matchesPath) != sizeof(MAGIC) + (uint64_t)count * RECORD_SIZE) {
+        TraceLog(LOG_WARNING, "LADDER: dropping a partial record at the end of %s (interrupted run)",
+                 matchesPath.c_str());
+        if (!CutPartialTail(sizeof(MAGIC) + (uint64_t)count * RECORD_SIZE)) return false;
+    }
+
+    // Unbuffered: every write is a whole block of records, never a split one
+    matchesOut.rdbuf()->pubsetbuf(nullptr, 0);
+    matchesOut.open(matchesPath, ios::binary | ios::app);
+    playersOut.open(base + ".players", ios::app);
+    if (!matchesOut || !playersOut) {
+        TraceLog(LOG_ERROR, "LADDER: cannot write to %s", base.c_str());
+        return false;
+    }
+    if (fresh) matchesOut.write(MAGIC, sizeof(MAGIC));
+
+    if (!IndexesCoverLog() && !RebuildIndexes()) return false;
+    return true;
+}
+
+bool MatchLog::OpenReadOnly(const string& path) {
+    string matchesPath = path + ".matches";
+    if (!FileExists(matchesPath.c_str())) {
+        TraceLog(LOG_ERROR, "LADDER: no ladder log at %s", matchesPath.c_str());
+        return false;
+    }
+    if (!Load(path)) return false;
+
+    if (FileSize(matchesPath) != sizeof(MAGIC) + (uint64_t)count * RECORD_SIZE)
+        TraceLog(LOG_WARNING, "LADDER: ignoring a partial record at the end of %s", matchesPath.c_str());
+
+    // Stale index files are left for the next Open() to rebuild
+    if (!IndexesCoverLog()) {
+        indexFiles = false;
+        uint32_t rec = 0;
+        if (!Scan([&](const MatchResult& r) { Index(rec++, r); })) return false;
+    }
+    return true;
+}
+
+// Streams can't shrink a file, so copy the whole records and swap files
+bool MatchLog::CutPartialTail(uint64_t validBytes) {
+    string path = base + ".matches";
+    string tmp  = path + ".tmp";
+    {
+        ifstream in(path, ios::binary);
+        ofstream out(tmp, ios::binary | ios::trunc);
+        vector<char> buf(RECORD_SIZE * FLUSH_RECORDS);
+        uint64_t left = validBytes;
+        while (left > 0 && in) {
+            size_t n = (size_t)min<uint64_t>(left, buf.size());
+            in.read(buf.data(), n);
+            out.write(buf.data(), in.gcount());
+            left -= (uint64_t)in.gcount();
+        }
+        if (left != 0 || !out) {
+            TraceLog(LOG_ERROR, "LADDER: could not repair %s", path.c_str());
+            return false;
+        }
+    }
+    remove(path.c_str());
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        TraceLog(LOG_ERROR, "LADDER: could not replace %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Only needed after a crash, or for logs written before the index files
+bool MatchLog::RebuildIndexes() {
+    if (count > 0) TraceLog(LOG_INFO, "LADDER: rebuilding indexes for %s", base.c_str());
+    for (size_t p = 0; p < players.size(); ++p) remove(IndexPath('p', p).c_str());
+    for (int w = 0; w < MAX_WEAPONS; ++w) remove(IndexPath('w', w).c_str());
+
+    uint32_t rec = 0;
+    bool ok = Scan([&](const MatchResult& r) {
+        Index(rec++, r);
+        if (rec % FLUSH_RECORDS == 0) WriteIndexes();
+    });
+    if (!ok) return false;
+    WriteIndexes();
+    WriteCoverage();
+    return true;
+}
+
+bool MatchLog::Scan(const function<void(const MatchResult&)>& onRecord) const {
+    ifstream in(base + ".matches", ios::binary);
+    in.seekg(sizeof(MAGIC));
+
+    // Stream through the records in big blocks rather than one at a time
+    vector<unsigned char> buf(RECORD_SIZE * FLUSH_RECORDS);
+    uint32_t rec = 0;
+    while (rec < count - pending.size() / RECORD_SIZE) {
+        in.read((char*)buf.data(), buf.size());
+        size_t got = (size_t)in.gcount();
+        if (got == 0) break;
+        for (size_t off = 0; off + RECORD_SIZE <= got; off += RECORD_SIZE, ++rec) {
+            MatchResult r = Decode(&buf[off]);
+            if (r.p0 >= players.size() || r.p1 >= players.size()) {
+                TraceLog(LOG_ERROR, "LADDER: record %u names an unknown player", rec);
+                return false;
+            }
+            onRecord(r);
+        }
+    }
+    for (size_t off = 0; off < pending.size(); off += RECORD_SIZE) onRecord(Decode(&pending[off]));
+    return true;
+}
+
+uint16_t MatchLog::PlayerId(const string& name) {
+    for (size_t i = 0; i < players.size(); ++i)
+        if (players[i] == name) return (uint16_t)i;
+
+    players.push_back(name);
+    pendingByPlayer.emplace_back();
+    playersOut << name << '\n';
+    playersOut.flush(); // ids must be on disk before any match that uses them
+    return (uint16_t)(players.size() - 1);
+}
+
+void MatchLog::Index(uint32_t rec, const MatchResult& r) {
+    pendingByPlayer[r.p0].push_back(rec);
+    if (r.p1 != r.p0) pendingByPlayer[r.p1].push_back(rec);
+    pendingByWeapon[(size_t)r.weapon].push_back(rec);
+}
+
+void MatchLog::Append(const MatchResult& r) {
+    size_t at = pending.size();
+    pending.resize(at + RECORD_SIZE);
+    Encode(r, &pending[at]);
+    Index(count++, r);
+    if (pending.size() >= RECORD_SIZE * FLUSH_RECORDS) Flush();
+}
+
+void MatchLog::WriteIndexes() {
+    vector<unsigned char> buf;
+    auto write = [&](char kind, size_t id, vector<uint32_t>& recs) {
+        if (recs.empty()) return;
+        buf.clear();
+        for (uint32_t rec : recs) PutU32(buf, rec);
+        ofstream out(IndexPath(kind, id), ios::binary | ios::app);
+        out.write((const char*)buf.data(), buf.size());
+        recs.clear();
+    };
+    for (size_t p = 0; p < pendingByPlayer.size(); ++p) write('p', p, pendingByPlayer[p]);
+    for (size_t w = 0; w < pendingByWeapon.size(); ++w) write('w', w, pendingByWeapon[w]);
+}
+
+void MatchLog::WriteCoverage() {
+    vector<unsigned char> buf;
+    PutU32(buf, count);
+    ofstream out(base + ".idx", ios::binary | ios::trunc);
+    out.write((const char*)buf.data(), buf.size());
+}
+
+// Records first, then the indexes, then the coverage mark. A crash anywhere
+// in between leaves a mark that doesn't match the log, which forces a rebuild.
+void MatchLog::Flush() {
+    if (!pending.empty()) {
+        matchesOut.write((const char*)pending.data(), pending.size());
+        matchesOut.flush();
+        pending.clear();
+    }
+    WriteIndexes();
+    WriteCoverage();
+}
+
+vector<uint32_t> MatchLog::LoadIndex(char kind, size_t id, const vector<vector<uint32_t>>& unwritten) const {
+    vector<uint32_t> recs;
+    ifstream in;
+    if (indexFiles) in.open(IndexPath(kind, id), ios::binary | ios::ate);
+    if (in.is_open()) {
+        size_t n = (size_t)in.tellg() / 4;
+        vector<unsigned char> buf(n * 4);
+        in.seekg(0);
+        in.read((char*)buf.data(), buf.size());
+        recs.reserve(n);
+        for (size_t i = 0; i < n; ++i) recs.push_back(GetU32(&buf[i * 4]));
+    }
+    if (id < unwritten.size()) recs.insert(recs.end(), unwritten[id].begin(), unwritten[id].end());
+    return recs;
+}
+
+vector<uint32_t> MatchLog::PlayerIndex(uint16_t id) const {
+    return LoadIndex('p', id, pendingByPlayer);
+}
+
+vector<uint32_t> MatchLog::WeaponIndex(WeaponType w) const {
+    return LoadIndex('w', (size_t)w, pendingByWeapon);
+}
+
+vector<MatchResult> MatchLog::Read(const vector<uint32_t>& recs) const {
+    vector<MatchResult> out;
+    out.reserve(recs.size());
+
+    uint32_t onDisk = count - (uint32_t)(pending.size() / RECORD_SIZE);
+    ifstream in(base + ".matches", ios::binary);
+    unsigned char b[RECORD_SIZE];
+    uint32_t next = UINT32_MAX; // record the stream is positioned at
+    for (uint32_t rec : recs) {
+        if (rec >= onDisk) {
+            out.push_back(Decode(&pending[(rec - onDisk) * RECORD_SIZE]));
+            continue;
+        }
+        // Indexes are ascending, so neighbouring records are read without a seek
+        if (rec != next) in.seekg(sizeof(MAGIC) + (streamoff)rec * RECORD_SIZE);
+        if (!in.read((char*)b, RECORD_SIZE)) break;
+        out.push_back(Decode(b));
+        next = rec + 1;
+    }
+    return out;
+}
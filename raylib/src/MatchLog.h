@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Match.h"
+
+// Append-only ladder history on disk:
+//   <base>.matches    8-byte header, then one 12-byte record per match
+//   <base>.players    one player name per line, the line number is the id
+//   <base>.p<N>.idx   record numbers of player N's matches, 4 bytes each
+//   <base>.w<N>.idx   record numbers of matches fought with weapon N
+//   <base>.idx        how many records the .idx files cover
+// Records are written in whole blocks and never rewritten. A half-written
+// record left by a crash is cut off on the next open, and the index files
+// are rebuilt from the records if they don't match the log.
+// OpenReadOnly() touches no files: it skips a half-written record and
+// indexes in memory instead when the index files are stale.
+class MatchLog {
+private:
+    std::string   base;
+    std::ofstream matchesOut;
+    std::ofstream playersOut;
+
+    std::vector<std::string> players;
+    uint32_t                 count;     // records, including unwritten ones
+    bool                     indexFiles; // false: indexes live in memory only
+
+    // Written out together by Flush()
+    std::vector<unsigned char>         pending;
+    std::vector<std::vector<uint32_t>> pendingByPlayer;
+    std::vector<std::vector<uint32_t>> pendingByWeapon;
+
+    std::string IndexPath(char kind, size_t id) const;
+    bool Load(const std::string& path);
+    bool IndexesCoverLog() const;
+    bool CutPartialTail(uint64_t validBytes);
+    bool RebuildIndexes();
+    void WriteIndexes();
+    void WriteCoverage();
+    void Index(uint32_t rec, const MatchResult& r);
+    std::vector<uint32_t> LoadIndex(char kind, size_t id, const std::vector<std::vector<uint32_t>>& unwritten) const;
+
+public:
+    MatchLog();
+    ~MatchLog();
+
+    bool Open(const std::string& path);         // for appending
+    bool OpenReadOnly(const std::string& path); // for queries, fails if there is no log
+
+    // Streams every stored match, in order; false if the log is corrupt
+    bool Scan(const std::function<void(const MatchResult&)>& onRecord) const;
+
+    uint16_t PlayerId(const std::string& name); // registers new names
+    void     Append(const MatchResult& r);
+    void     Flush();
+
+    uint32_t Count() const { return count; }
+    const std::vector<std::string>& Players() const { return players; }
+
+    // Record numbers from the on-disk indexes, ascending
+    std::vector<uint32_t> PlayerIndex(uint16_t id) const;
+    std::vector<uint32_t> WeaponIndex(WeaponType w) const;
+    std::vector<MatchResult> Read(const std::vector<uint32_t>& recs) const;
+};
@@ -1,6 +1,7 @@
 #include "Projectile.h"
 #include <cmath>
 #include "Theme.h"
+#include "Rules.h"
 
 using namespace std;
 
@@ -22,9 +23,7 @@ void Projectile::Fire(Vector2 start, Vector2 velocity, WeaponType t, int player)
 void Projectile::Update(float dt) {
     if (!active) return;
 
-    const float GRAVITY = 300.0f;
-
-    vel.y += GRAVITY * dt;
+    vel.y += Rules::Gravity * dt;
     pos.x += vel.x * dt;
     pos.y += vel.y * dt;
 
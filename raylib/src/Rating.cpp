@@ -0,0 +1,53 @@
+#include "Rating.h"
+#include <cmath>
+
+using namespace std;
+
+static const double ELO_START    = 1500.0;
+static const double ELO_K        = 24.0;
+static const double GLICKO_START = 1500.0;
+static const double RD_START     = 350.0;
+static const double RD_MIN       = 30.0;    // keeps ratings able to move on long ladders
+static const double PI           = 3.14159265358979;
+static const double Q            = log(10.0) / 400.0;
+
+Rating::Rating()
+    : elo(ELO_START), glicko(GLICKO_START), rd(RD_START),
+      wins(0), losses(0), draws(0)
+{
+}
+
+static double EloExpected(double ra, double rb) {
+    return 1.0 / (1.0 + pow(10.0, (rb - ra) / 400.0));
+}
+
+static double GlickoG(double rd) {
+    return 1.0 / sqrt(1.0 + 3.0 * Q * Q * rd * rd / (PI * PI));
+}
+
+// Glicko-1 update of 'r' after one game against 'opp'
+static void GlickoUpdate(double& r, double& rd, double oppR, double oppRd, double score) {
+    double g  = GlickoG(oppRd);
+    double e  = 1.0 / (1.0 + pow(10.0, -g * (r - oppR) / 400.0));
+    double d2 = 1.0 / (Q * Q * g * g * e * (1.0 - e));
+    double denom = 1.0 / (rd * rd) + 1.0 / d2;
+
+    r  += Q / denom * g * (score - e);
+    rd  = sqrt(1.0 / denom);
+    if (rd < RD_MIN) rd = RD_MIN;
+}
+
+void UpdateRatings(Rating& a, Rating& b, double score) {
+    double ea = EloExpected(a.elo, b.elo);
+    a.elo += ELO_K * (score - ea);
+    b.elo += ELO_K * ((1.0 - score) - (1.0 - ea));
+
+    // Both sides update from the pre-game numbers
+    double ar = a.glicko, ard = a.rd;
+    GlickoUpdate(a.glicko, a.rd, b.glicko, b.rd, score);
+    GlickoUpdate(b.glicko, b.rd, ar, ard, 1.0 - score);
+
+    if (score > 0.75)      { a.wins++;  b.losses++; }
+    else if (score < 0.25) { a.losses++; b.wins++; }
+    else                   { a.draws++; b.draws++; }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// A ladder player's standing. Elo and Glicko are tracked side by side;
+// every match is treated as its own Glicko rating period.
+struct Rating {
+    double elo;
+    double glicko;
+    double rd;          // Glicko rating deviation
+    int    wins, losses, draws;
+
+    Rating();
+
+    int Games() const { return wins + losses + draws; }
+};
+
+// score is from a's point of view: 1 win, 0.5 draw, 0 loss
+void UpdateRatings(Rating& a, Rating& b, double score);
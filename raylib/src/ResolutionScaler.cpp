@@ -0,0 +1,109 @@
+#include "ResolutionScaler.h"
+#include <cmath>
+
+using namespace std;
+
+static const float SCALE_STEP     = 0.125f; // coarse steps, each one reallocates the target
+static const float SMOOTHING      = 0.1f;
+static const int   SETTLE_FRAMES  = 30;
+static const float OVER_BUDGET    = 1.10f;  // a missed frame at the target FPS
+static const float HEADROOM       = 0.50f;  // plenty of time left over
+static const int   RAISE_FRAMES   = 60;     // headroom needed for a normal step up
+static const int   RETRY_FRAMES   = 600;    // ... and before retrying a failed scale
+static const int   RETRY_MAX      = 7200;
+static const int   STABLE_FRAMES  = 1800;   // a retried scale this long is trusted again
+
+ResolutionScaler::ResolutionScaler(int targetFps)
+    : budget(1.0f / (float)targetFps),
+      minScale(0.5f),
+      maxScale(1.0f),
+      scale(1.0f),
+      overHistory{},
+      overPos(0),
+      overCount(0),
+      avgWork(0.0f),
+      cooldown(SETTLE_FRAMES),
+      failedScale(0.0f),
+      retryFrames(RETRY_FRAMES),
+      retrying(false),
+      headroom(0),
+      stable(0)
+{
+}
+
+void ResolutionScaler::SetLimits(float lo, float hi) {
+    // Stay on the step grid here too, or every frame of a window drag
+    // would hand the viewport a slightly different target size
+    minScale = lo;
+    maxScale = floorf(hi / SCALE_STEP) * SCALE_STEP;
+    if (maxScale < minScale) maxScale = minScale;
+    if (scale > maxScale) scale = maxScale;
+    if (scale < minScale) scale = minScale;
+}
+
+void ResolutionScaler::SetScale(float s) {
+    s = floorf(s / SCALE_STEP) * SCALE_STEP;
+    if (s > maxScale) s = maxScale;
+    if (s < minScale) s = minScale;
+    scale = s;
+    Settle();
+}
+
+// Timings from before a change say nothing about the new scale
+void ResolutionScaler::Settle() {
+    cooldown = SETTLE_FRAMES;
+    headroom = 0;
+    stable = 0;
+    for (int i = 0; i < WINDOW; ++i) overHistory[i] = false;
+    overCount = 0;
+}
+
+float ResolutionScaler::Update(float frameTime, float workTime) {
+    avgWork += (workTime - avgWork) * SMOOTHING;
+
+    if (cooldown > 0) { cooldown--; return scale; }
+
+    bool over = frameTime > budget * OVER_BUDGET;
+    overCount += (int)over - (int)overHistory[overPos];
+    overHistory[overPos] = over;
+    overPos = (overPos + 1) % WINDOW;
+
+    headroom = (!over && avgWork < budget * HEADROOM) ? headroom + 1 : 0;
+
+    if (retrying && !over && ++stable >= STABLE_FRAMES) {
+        failedScale = 0.0f;
+        retryFrames = RETRY_FRAMES;
+        retrying = false;
+    }
+
+    float next = scale;
+    if (overCount * 2 >= WINDOW) {
+        next = scale - SCALE_STEP;
+    } else {
+        float up = scale + SCALE_STEP;
+        int need = (failedScale > 0.0f && up >= failedScale) ? retryFrames : RAISE_FRAMES;
+        if (headroom >= need) next = up;
+    }
+
+    // Snap to the step grid so small window changes don't cause reallocations
+    next = floorf(next / SCALE_STEP + 0.5f) * SCALE_STEP;
+    if (next > maxScale) next = maxScale;
+    if (next < minScale) next = minScale;
+    if (next == scale) return scale;
+
+    if (next < scale) {
+        // The retried scale failed again: wait twice as long next time
+        if (retrying)
+            retryFrames = (retryFrames * 2 > RETRY_MAX) ? RETRY_MAX : retryFrames * 2;
+        if (failedScale == 0.0f || scale < failedScale) failedScale = scale;
+        retrying = false;
+    } else if (failedScale > 0.0f && next >= failedScale) {
+        retrying = true;
+    }
+
+    scale = next;
+    Settle();
+    return scale;
+}
+
+float ResolutionScaler::GetScale() const { return scale; }
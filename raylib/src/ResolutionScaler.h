@@ -0,0 +1,44 @@
+#pragma once
+
+// Picks the internal render scale each frame so the game holds its target
+// frame rate: drops resolution when frames keep running long, raises it
+// again when there is headroom, up to the native resolution of the window.
+//
+// Only a sustained overrun steps down (half of a short window of frames over
+// budget), so a single hitch such as a shader compile leaves the scale alone.
+//
+// CPU headroom says nothing about GPU cost, so a scale that already missed
+// the budget is only retried after a long stretch of headroom, and that
+// wait doubles every time the retry fails. This keeps a GPU-bound machine
+// from bouncing between two scales (each change reallocates the target).
+class ResolutionScaler {
+private:
+    static const int WINDOW = 30;
+
+    float budget;       // seconds per frame at the target FPS
+    float minScale;
+    float maxScale;
+    float scale;
+
+    bool  overHistory[WINDOW]; // which of the recent frames missed the budget
+    int   overPos, overCount;
+    float avgWork;      // smoothed CPU time spent updating and drawing
+    int   cooldown;     // frames to wait before the next change
+
+    float failedScale;  // lowest scale that missed the budget, 0 = none
+    int   retryFrames;  // headroom frames needed before trying it again
+    bool  retrying;     // running at or above failedScale after a step up
+    int   headroom;     // consecutive frames with headroom
+    int   stable;       // frames survived at or above failedScale
+
+    void Settle();
+
+public:
+    ResolutionScaler(int targetFps);
+
+    void  SetLimits(float lo, float hi);
+    void  SetScale(float s);    // jump straight there, e.g. native on start
+    float Update(float frameTime, float workTime);
+
+    float GetScale() const;
+};
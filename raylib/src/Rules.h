@@ -0,0 +1,15 @@
+#pragma once
+
+// Gameplay numbers shared by the game and the headless match simulation
+namespace Rules {
+    static const float Gravity     = 300.0f;
+    static const float BaseSpeed   = 300.0f;    // projectile speed at zero power
+    static const float PowerMult   = 300.0f;    // extra speed at full power
+    static const float MinPower    = 0.1f;
+    static const float PowerRate   = 0.5f;      // power gained per second held
+    static const float HitDamage   = 35.0f;
+
+    static const float GroundDepth = 80.0f;     // ground strip height, from the bottom
+    static const float TankInset   = 150.0f;    // tank start distance from the sides
+    static const float SimDt       = 1.0f / 120.0f;
+}
@@ -0,0 +1,228 @@
+#include "SceneRender.h"
+#include "Game.h"
+#include "Viewport.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+    #include <direct.h>
+    #define MAKE_DIR(path) _mkdir(path)
+#else
+    #include <sys/stat.h>
+    #define MAKE_DIR(path) mkdir(path, 0755)
+#endif
+
+using namespace std;
+
+static const int   SCENE_W        = 1280;
+static const int   SCENE_H        = 720;
+static const int   WARMUP_FRAMES  = 5;
+// Large enough that the vertex buffer doesn't fill during a scene. rlgl still
+// flushes (and resets the draw counter) at RL_DEFAULT_BATCH_DRAWCALLS draw
+// calls, so a scene that reaches that many is reported as a failure.
+static const int   BATCH_ELEMENTS = 65536;
+static const float MAX_BAD_PIXELS = 0.001f; // fraction of pixels allowed past the tolerance
+
+struct Scene {
+    const char*    name;
+    GameState      state;
+    BackgroundType bg;
+};
+
+static const Scene SCENES[] = {
+    { "menu",            GameState::Menu,             BackgroundType::Desert },
+    { "bg_select",       GameState::BackgroundSelect, BackgroundType::Desert },
+    { "game_desert",     GameState::Playing,          BackgroundType::Desert },
+    { "game_moon",       GameState::Playing,          BackgroundType::MoonNight },
+    { "gameover_desert", GameState::GameOver,         BackgroundType::Desert },
+    { "gameover_moon",   GameState::GameOver,         BackgroundType::MoonNight },
+};
+
+struct BenchRow {
+    float ms;
+    int   draws;
+};
+
+// One level only; the parent directory has to exist
+static bool EnsureDirectory(const char* path) {
+    struct stat st;
+    if (stat(path, &st) == 0) return (st.st_mode & S_IFDIR) != 0;
+    return MAKE_DIR(path) == 0;
+}
+
+static Image ReadBack(const RenderTexture2D& target) {
+    Image img = LoadImageFromTexture(target.texture);
+    ImageFlipVertical(&img); // render textures are stored upside down
+    return img;
+}
+
+// Number of pixels where some channel differs by more than 'tolerance'
+static int CountBadPixels(Image a, Image b, int tolerance) {
+    if (a.width != b.width || a.height != b.height) return a.width * a.height;
+
+    Color* pa = LoadImageColors(a);
+    Color* pb = LoadImageColors(b);
+    int bad = 0;
+    for (int i = 0; i < a.width * a.height; ++i) {
+        if (abs(pa[i].r - pb[i].r) > tolerance || abs(pa[i].g - pb[i].g) > tolerance ||
+            abs(pa[i].b - pb[i].b) > tolerance || abs(pa[i].a - pb[i].a) > tolerance)
+            bad++;
+    }
+    UnloadImageColors(pa);
+    UnloadImageColors(pb);
+    return bad;
+}
+
+static map<string, BenchRow> LoadBaseline(const char* path) {
+    map<string, BenchRow> rows;
+    ifstream in(path);
+    string line;
+    getline(in, line); // header
+    while (getline(in, line)) {
+        istringstream ss(line);
+        string name, ms, draws;
+        if (getline(ss, name, ',') && getline(ss, ms, ',') && getline(ss, draws, ','))
+            rows[name] = { strtof(ms.c_str(), nullptr), atoi(draws.c_str()) };
+    }
+    return rows;
+}
+
+int RunSceneRender(int argc, char** argv) {
+    const char* outDir   = nullptr;
+    const char* golden   = nullptr;
+    const char* baseline = nullptr;
+    int   tolerance = 8;      // software rasterizers differ slightly in edge AA
+    float msSlack   = 1.25f;
+    int   frames    = 60;
+
+    for (int i = 1; i < argc; ++i) {
+        bool more = (i + 1 < argc);
+        if      (!strcmp(argv[i], "--render-scenes") && more) outDir = argv[++i];
+        else if (!strcmp(argv[i], "--golden") && more)        golden = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && more)     tolerance = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--baseline") && more)      baseline = argv[++i];
+        else if (!strcmp(argv[i], "--ms-slack") && more)      msSlack = strtof(argv[++i], nullptr);
+        else if (!strcmp(argv[i], "--frames") && more)        frames = atoi(argv[++i]);
+    }
+    if (!outDir) {
+        fprintf(stderr, "--render-scenes needs an output directory\n");
+        return 1;
+    }
+    if (frames < 1) frames = 1;
+
+    if (!EnsureDirectory(outDir)) {
+        fprintf(stderr, "Cannot create output directory %s\n", outDir);
+        return 1;
+    }
+    string csvPath = string(outDir) + "/render_bench.csv";
+    ofstream csv(csvPath);
+    if (!csv) {
+        fprintf(stderr, "Cannot write %s\n", csvPath.c_str());
+        return 1;
+    }
+    csv << "scene,ms_per_frame,draw_calls\n";
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCENE_W, SCENE_H, "BlastForge - offscreen");
+    if (!IsWindowReady()) {
+        fprintf(stderr, "Could not create a GL context (try LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a -s \"-screen 0 1280x720x24\")\n");
+        return 1;
+    }
+    // Our own batch so the draw calls of a frame can be read before the flush
+    rlRenderBatch batch = rlLoadRenderBatch(1, BATCH_ELEMENTS);
+    rlSetRenderBatchActive(&batch);
+
+    map<string, BenchRow> base;
+    if (baseline) base = LoadBaseline(baseline);
+
+    int failures = 0;
+    printf("%-18s %10s %8s  %s\n", "SCENE", "MS/FRAME", "DRAWS", "CHECK");
+
+    {
+        Viewport view(SCENE_W, SCENE_H);
+        view.Init(1.0f);
+        Game game(SCENE_W, SCENE_H);
+        game.Init(false);
+
+        for (const Scene& sc : SCENES) {
+            game.ShowScene(sc.state, sc.bg);
+
+            int draws = 0;
+            for (int f = 0; f < WARMUP_FRAMES; ++f) {
+                view.Begin(); game.Draw(); view.End();
+            }
+
+            // Time a run of frames; the readback at the end waits for the GPU
+            double t0 = GetTime();
+            for (int f = 0; f < frames; ++f) {
+                view.Begin();
+                game.Draw();
+                draws = batch.drawCounter;
+                view.End();
+            }
+            Image img = ReadBack(view.GetTarget());
+            float ms = (float)((GetTime() - t0) * 1000.0 / frames);
+
+            string name = sc.name;
+            csv << name << ',' << ms << ',' << draws << '\n';
+
+            string check;
+            string png = string(outDir) + "/" + name + ".png";
+            if (!ExportImage(img, png.c_str())) {
+                check += "could not write " + png + " ";
+                failures++;
+            }
+            if (draws >= RL_DEFAULT_BATCH_DRAWCALLS) {
+                check += "draw calls hit the batch limit, count unreliable ";
+                failures++;
+            }
+            if (golden) {
+                string gp = string(golden) + "/" + name + ".png";
+                if (!FileExists(gp.c_str())) {
+                    check += "no golden ";
+                    failures++;
+                } else {
+                    Image ref = LoadImage(gp.c_str());
+                    int bad = CountBadPixels(img, ref, tolerance);
+                    UnloadImage(ref);
+                    if (bad > (int)(MAX_BAD_PIXELS * img.width * img.height)) {
+                        check += "image differs (" + to_string(bad) + " px) ";
+                        failures++;
+                    } else {
+                        check += "image ok ";
+                    }
+                }
+            }
+            auto it = base.find(name);
+            if (it != base.end()) {
+                if (draws > it->second.draws) {
+                    check += "draws " + to_string(it->second.draws) + "->" + to_string(draws) + " ";
+                    failures++;
+                }
+                if (ms > it->second.ms * msSlack) {
+                    check += "slower than baseline ";
+                    failures++;
+                }
+            }
+            UnloadImage(img);
+
+            printf("%-18s %10.3f %8d  %s\n", sc.name, ms, draws, check.c_str());
+        }
+        view.Unload();
+    }
+
+    rlSetRenderBatchActive(nullptr);
+    rlUnloadRenderBatch(batch);
+    CloseWindow();
+
+    printf("\nImages and %s written; %d check(s) failed\n", csvPath.c_str(), failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// Renders every screen of the game offscreen, with no visible window, to
+// dump images, compare them against golden images and time each scene:
+//
+//   game --render-scenes <outdir> [--golden DIR] [--tolerance N]
+//        [--baseline CSV] [--ms-slack X] [--frames N]
+//
+// On GPU-less machines run it on Mesa's software rasterizer under Xvfb with
+// a 24-bit screen (Xvfb defaults to 8-bit, which GLX can't use):
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a -s "-screen 0 1280x720x24" ./game --render-scenes out
+// This command has not been run against a real build yet.
+//
+// Writes <outdir>/<scene>.png and <outdir>/render_bench.csv (scene, ms per
+// frame, draw calls). Returns non-zero if an image differs from its golden
+// or a scene got slower / issues more draw calls than the baseline CSV.
+int RunSceneRender(int argc, char** argv);
@@ -17,16 +17,14 @@ void Tank::Init(Vector2 p) {
     destroyed = false;
 }
 
-void Tank::Update(bool active, int left, int right, int up, int down, float dt) {
+void Tank::Update(bool active, float move, float aim, float dt) {
     if (!active || destroyed) return;
 
     float speed = 200.0f;
     float rot = 60.0f;
 
-    if (IsKeyDown(left))  pos.x -= speed * dt;
-    if (IsKeyDown(right)) pos.x += speed * dt;
-    if (IsKeyDown(up))    barrelAngle += rot * dt;
-    if (IsKeyDown(down))  barrelAngle -= rot * dt;
+    pos.x       += move * speed * dt;
+    barrelAngle += aim * rot * dt;
 
     if (barrelAngle < 5.0f) barrelAngle = 5.0f;
     if (barrelAngle > 175.0f) barrelAngle = 175.0f;
@@ -11,7 +11,7 @@ private:
 public:
     Tank();
     void Init(Vector2 p);
-    void Update(bool active, int left, int right, int up, int down, float dt);
+    void Update(bool active, float move, float aim, float dt); // move/aim in -1..1
     
     Rectangle GetBody() const;
     void Draw(Color mainColor) const;
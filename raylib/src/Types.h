@@ -14,4 +14,24 @@ enum class BackgroundType {
 
 enum class WeaponType {
     Rocket
-};
\ No newline at end of file
+};
+
+// Per-player actions the simulation understands; bound to keys/pads in Input
+enum class InputAction {
+    MoveLeft,
+    MoveRight,
+    AimUp,
+    AimDown,
+    PowerDown,
+    PowerUp,
+    Fire,
+    Count
+};
+
+enum class SoundId {
+    Fire,
+    Impact,
+    Explosion,
+    Click,
+    Count
+};
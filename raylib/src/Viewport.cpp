@@ -0,0 +1,82 @@
+#include "Viewport.h"
+#include <cmath>
+
+using namespace std;
+
+Viewport::Viewport(int W, int H)
+    : virtualW(W), virtualH(H),
+      renderScale(1.0f),
+      loaded(false)
+{
+    target = {};
+    dest = { 0, 0, (float)W, (float)H };
+}
+
+void Viewport::Init(float scale) {
+    renderScale = scale;
+    Update();
+    Reload();
+}
+
+void Viewport::Unload() {
+    if (loaded) UnloadRenderTexture(target);
+    loaded = false;
+}
+
+void Viewport::Reload() {
+    Unload();
+    int tw = (int)lroundf(virtualW * renderScale);
+    int th = (int)lroundf(virtualH * renderScale);
+    target = LoadRenderTexture(tw, th);
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    loaded = true;
+}
+
+void Viewport::Update() {
+    float sw = (float)GetScreenWidth();
+    float sh = (float)GetScreenHeight();
+
+    // Fit the virtual aspect ratio inside the window, bars on the short side
+    float fit = fminf(sw / virtualW, sh / virtualH);
+    dest.width  = virtualW * fit;
+    dest.height = virtualH * fit;
+    dest.x = (sw - dest.width)  / 2.0f;
+    dest.y = (sh - dest.height) / 2.0f;
+
+    // Buttons keep working in virtual pixels no matter the window size
+    SetMouseOffset((int)-dest.x, (int)-dest.y);
+    SetMouseScale(virtualW / dest.width, virtualH / dest.height);
+}
+
+void Viewport::SetRenderScale(float s) {
+    if (fabsf(s - renderScale) < 0.001f) return;
+    renderScale = s;
+    Reload();
+}
+
+float Viewport::GetRenderScale() const { return renderScale; }
+
+float Viewport::GetNativeScale() const {
+    // Window size is in screen coordinates; HiDPI displays render more pixels
+    float dpi = (float)GetRenderWidth() / (float)GetScreenWidth();
+    return dest.width / virtualW * dpi;
+}
+
+void Viewport::Begin() {
+    BeginTextureMode(target);
+    Camera2D cam = { { 0, 0 }, { 0, 0 }, 0.0f, renderScale };
+    BeginMode2D(cam);
+}
+
+void Viewport::End() {
+    EndMode2D();
+    EndTextureMode();
+}
+
+void Viewport::Present() const {
+    ClearBackground(BLACK); // letterbox bars
+
+    // Render textures are stored upside down, hence the negative height
+    Rectangle src = { 0, 0, (float)target.texture.width, -(float)target.texture.height };
+    DrawTexturePro(target.texture, src, dest, { 0, 0 }, 0.0f, WHITE);
+}
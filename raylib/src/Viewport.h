@@ -0,0 +1,36 @@
+#pragma once
+#include "raylib.h"
+
+// Draws the game at a fixed virtual resolution into an offscreen target and
+// presents it letterboxed into whatever size the window currently has.
+class Viewport {
+private:
+    int   virtualW, virtualH;
+    float renderScale;      // internal resolution relative to the virtual one
+
+    RenderTexture2D target;
+    bool            loaded;
+    Rectangle       dest;   // letterboxed area on the window, in window pixels
+
+    void Reload();
+
+public:
+    Viewport(int W, int H);
+
+    void Init(float scale);
+    void Unload();
+
+    // Recomputes the letterbox and maps the mouse into virtual coordinates.
+    // Call once per frame before anything reads GetMousePosition().
+    void Update();
+
+    void  SetRenderScale(float s);
+    float GetRenderScale() const;
+    float GetNativeScale() const; // scale that matches the letterbox 1:1
+
+    void Begin();   // start drawing in virtual coordinates
+    void End();
+    void Present() const; // call between BeginDrawing() / EndDrawing()
+
+    const RenderTexture2D& GetTarget() const { return target; }
+};
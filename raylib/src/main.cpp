@@ -1,27 +1,116 @@
 #include "raylib.h"
 #include "Game.h"
+#include "Viewport.h"
+#include "ResolutionScaler.h"
+#include "Ladder.h"
+#include "SceneRender.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 using namespace std;
 
-int main() {
+int main(int argc, char** argv) {
+    // Command line tools that run without a visible window
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--ladder") || !strcmp(argv[i], "--ladder-query") ||
+            !strcmp(argv[i], "--ladder-query-weapon"))
+            return RunLadder(argc, argv);
+        if (!strcmp(argv[i], "--render-scenes"))
+            return RunSceneRender(argc, argv);
+        if (!strcmp(argv[i], "--audio-check"))
+            return RunAudioCheck();
+    }
+
+    // Virtual resolution: all layout in Game is in these units
     const int SCREEN_WIDTH  = 1280;
     const int SCREEN_HEIGHT = 720;
+    const int TARGET_FPS    = 60;
 
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "BlastForge - Tactical Tank Warfare");
-    SetTargetFPS(60);
-         
-    Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
-    game.Init();
-
-    while (!WindowShouldClose() && !game.ShouldQuit()) {
-        float dt = GetFrameTime();
-        game.Update(dt);
-        BeginDrawing();
-        game.Draw();
-        EndDrawing();
+    SetWindowMinSize(SCREEN_WIDTH / 4, SCREEN_HEIGHT / 4);
+    // No target FPS: the loop paces itself after the present timestamp
+    SetTargetFPS(0);
+
+    // BLASTFORGE_AUDIO=off runs silent, e.g. on machines without sound
+    const char* audioEnv = getenv("BLASTFORGE_AUDIO");
+    if (!audioEnv || strcmp(audioEnv, "off") != 0) InitAudioDevice();
+
+    // Start at native resolution and let the scaler lower it if it must
+    Viewport view(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ResolutionScaler scaler(TARGET_FPS);
+    view.Update();
+    scaler.SetLimits(0.5f, view.GetNativeScale());
+    scaler.SetScale(view.GetNativeScale());
+    view.Init(scaler.GetScale());
+
+    {   // Game releases its sounds on destruction, before the device closes
+        Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
+        game.Init(IsAudioDeviceReady());
+
+        // BLASTFORGE_INPUT=legacy samples fire per frame as before, to compare latency
+        const char* inputEnv = getenv("BLASTFORGE_INPUT");
+        game.SetLegacyInput(inputEnv && strcmp(inputEnv, "legacy") == 0);
+
+        const double FRAME_TIME = 1.0 / TARGET_FPS;
+        double frameStart = GetTime();
+        int  windowedW = SCREEN_WIDTH, windowedH = SCREEN_HEIGHT;
+        float toggledFrom = 0.0f;   // native scale before F11, 0 = none pending
+
+        while (!WindowShouldClose() && !game.ShouldQuit()) {
+            // raylib 4.5 keeps the window's size as the fullscreen video
+            // mode, so switch to the monitor's size first and back after
+            if (IsKeyPressed(KEY_F11)) {
+                if (!IsWindowFullscreen()) {
+                    windowedW = GetScreenWidth();
+                    windowedH = GetScreenHeight();
+                    int monitor = GetCurrentMonitor();
+                    SetWindowSize(GetMonitorWidth(monitor), GetMonitorHeight(monitor));
+                    ToggleFullscreen();
+                } else {
+                    ToggleFullscreen();
+                    SetWindowSize(windowedW, windowedH);
+                }
+                toggledFrom = view.GetNativeScale();
+            }
+
+            float dt = GetFrameTime();
+            double workStart = GetTime();
+
+            view.Update();
+            if (toggledFrom > 0.0f && view.GetNativeScale() != toggledFrom) {
+                // The new size arrives with the events of a later poll;
+                // start that size at native too instead of climbing to it
+                scaler.SetLimits(0.5f, view.GetNativeScale());
+                scaler.SetScale(view.GetNativeScale());
+                view.SetRenderScale(scaler.GetScale());
+                toggledFrom = 0.0f;
+            }
+            game.Update();
+
+            view.Begin();
+            game.Draw();
+            view.End();
+
+            float work = (float)(GetTime() - workStart);
+
+            BeginDrawing();
+            view.Present();
+            EndDrawing();   // swap, then poll input; no wait with target FPS 0
+            game.Presented(GetTime());
+
+            scaler.SetLimits(0.5f, view.GetNativeScale());
+            view.SetRenderScale(scaler.Update(dt, work));
+
+            double left = frameStart + FRAME_TIME - GetTime();
+            if (left > 0.0) WaitTime(left);
+            frameStart = GetTime();
+        }
     }
 
+    view.Unload();
+    if (IsAudioDeviceReady()) CloseAudioDevice();
     CloseWindow();
     return 0;
-}
\ No newline at end of file
+}